@@ -107,9 +107,6 @@ int main(void) {
   return 0;
 }
 
-bool one_pressed  = false;
-bool two_pressed = false;
-
 void game_main(void) {
   if(window.keyDown(SDL_SCANCODE_RIGHT)) {
     anim_controller.setX(anim_controller.getX() + 128*window.getDeltaTime());
@@ -130,19 +127,11 @@ void game_main(void) {
 
 
 
-  if(window.keyDown(SDL_SCANCODE_1) && !one_pressed) {
+  if(window.keyPressed(SDL_SCANCODE_1)) {
     anim_controller.setAnimation("animation01");
-    one_pressed = true;
-  }
-  else if(!window.keyDown(SDL_SCANCODE_1) && one_pressed) {
-    one_pressed = false;
   }
 
-  if(window.keyDown(SDL_SCANCODE_2) && !two_pressed) {
+  if(window.keyPressed(SDL_SCANCODE_2)) {
     anim_controller.setAnimation("animation02");
-    two_pressed = true;
-  }
-  else if(!window.keyDown(SDL_SCANCODE_2) && two_pressed) {
-    two_pressed = false;
   }
 }
@@ -0,0 +1,138 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file components.h
+ *
+ * A blackhole library set of built in components for ecs::Registry
+ */
+
+#pragma once
+#ifndef ECS_COMPONENTS_H
+#define ECS_COMPONENTS_H
+
+#include <SDL2/SDL.h>
+#include "../graphics/imageBase.h"
+#include "../graphics/spritesheet.h"
+#include "../graphics/animation_system.h"
+
+namespace blackhole {
+namespace ecs {
+
+  /**
+   *  \brief The position of an entity
+   */
+  struct Transform {
+    float x;  /**< x position */
+    float y;  /**< y position */
+  };
+
+  /**
+   *  \brief Movement in pixels per second, applied by integrate()
+   */
+  struct Velocity {
+    float x;  /**< x speed */
+    float y;  /**< y speed */
+  };
+
+  /**
+   *  \brief The draw order of an entity, lower layers are drawn first
+   */
+  struct Layer {
+    int layer;  /**< The layer */
+  };
+
+  /**
+   *  \brief A texture drawn at the Transform of an entity
+   */
+  struct Renderable {
+    SDL_Texture* texture;    /**< The texture to copy from */
+    SDL_Rect src;            /**< The rect of the texture to copy */
+    int w;                   /**< The width drawn */
+    int h;                   /**< The height drawn */
+    SDL_RendererFlip flip;   /**< The flip to copy with */
+    bool hasSrc;             /**< false to copy the whole texture */
+  };
+
+  /**
+   *  \brief A slot in an AnimationSystem that picks the frame of the
+   *         Renderable. Registry::add() clones the given slot for each
+   *         entity and frees it when the component is removed
+   */
+  struct Animated {
+    graphics::AnimationSystem* system;  /**< The AnimationSystem of the slot */
+    int slot;                           /**< The slot */
+  };
+
+  /**
+   *  \brief Make a Renderable drawing what an ImageBase currently draws
+   *
+   *  \param image The ImageBase to copy from eg. an Image or SpriteSheet
+   *
+   *  \return Renderable of the image
+   */
+  Renderable makeRenderable(graphics::ImageBase* image);
+
+  /**
+   *  \brief An animation for entities to clone. It owns a slot in an
+   *         AnimationSystem that Registry::add() copies for each entity,
+   *         so it only has to be made once per animation and frees its
+   *         slot when it is destroyed
+   */
+  class AnimatedPrototype {
+  private:
+    Animated animated;
+  public:
+
+    /**
+     *  \brief Create the slot of the prototype
+     *
+     *  \param sheet The SpriteSheet of the frames
+     *  \param frames The frames of the animation. An error is printed
+     *         and frame 0 is shown if there are none
+     *  \param num_frames The amount of frames
+     *  \param speed Seconds per frame. 0 uses the frame durations of the
+     *         sheet, or 0.1 seconds if a frame has no duration eg. in a
+     *         grid SpriteSheet
+     *  \param system The AnimationSystem to use. NULL for the default
+     */
+    AnimatedPrototype(graphics::SpriteSheet* sheet, int* frames, int num_frames, float speed = 0, graphics::AnimationSystem* system = NULL);
+    AnimatedPrototype(const AnimatedPrototype&) = delete;
+    AnimatedPrototype& operator=(const AnimatedPrototype&) = delete;
+
+    /**
+     *  \brief Frees the slot. Entities keep their own copies
+     */
+    ~AnimatedPrototype();
+
+    /**
+     *  \brief Get the Animated to give to Registry::add()
+     *
+     *  \return const Animated& of the prototype slot
+     */
+    const Animated& get() const;
+  };
+}}
+
+#endif
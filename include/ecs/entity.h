@@ -0,0 +1,74 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file entity.h
+ *
+ * A blackhole library handle for entities in an ecs::Registry
+ */
+
+#pragma once
+#ifndef ECS_ENTITY_H
+#define ECS_ENTITY_H
+
+#include <SDL2/SDL.h>
+
+namespace blackhole {
+namespace ecs {
+
+  /**
+   *  \brief The handle of an entity. The low 24 bits are the index into
+   *         the Registry and the high 8 bits a version that changes when
+   *         the index is reused, so stale handles are caught
+   */
+  typedef Uint32 Entity;
+
+  const Uint32 ENTITY_INDEX_BITS = 24;                            /**< Bits used by the index */
+  const Uint32 ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1; /**< Mask of the index */
+  const Entity NULL_ENTITY = 0xFFFFFFFF;                          /**< An Entity that is never valid */
+
+  /**
+   *  \brief Get the index of an Entity
+   *
+   *  \param entity The Entity
+   *
+   *  \return Uint32 of the index
+   */
+  inline Uint32 entityIndex(Entity entity) {
+    return entity & ENTITY_INDEX_MASK;
+  }
+
+  /**
+   *  \brief Get the version of an Entity
+   *
+   *  \param entity The Entity
+   *
+   *  \return Uint32 of the version
+   */
+  inline Uint32 entityVersion(Entity entity) {
+    return entity >> ENTITY_INDEX_BITS;
+  }
+}}
+
+#endif
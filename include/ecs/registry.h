@@ -0,0 +1,217 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file registry.h
+ *
+ * A blackhole library class owning entities and their components
+ */
+
+#pragma once
+#ifndef ECS_REGISTRY_H
+#define ECS_REGISTRY_H
+
+#include <vector>
+#include "entity.h"
+#include "sparse_set.h"
+#include "components.h"
+
+namespace blackhole {
+namespace ecs {
+
+  /**
+   *  \brief The class owning entities and the Transform, Velocity, Layer,
+   *         Renderable and Animated components. Destroyed entities are
+   *         recycled and every component lives in a packed SparseSet, so
+   *         after reserve() spawning and destroying does not allocate
+   */
+  class Registry {
+  private:
+    std::vector<Entity> entities;
+    std::vector<Uint8> alive;
+    std::vector<Uint32> freeIndices;
+    int count;
+
+    SparseSet<Transform> transforms;
+    SparseSet<Velocity> velocities;
+    SparseSet<Layer> layers;
+    SparseSet<Renderable> renderables;
+    SparseSet<Animated> animations;
+
+    void release(Entity entity);
+  public:
+
+    /**
+     *  \brief The constructor of Registry
+     *
+     *  \param capacity The number of entities to reserve room for
+     */
+    Registry(int capacity = 0);
+    ~Registry();
+
+    /**
+     *  \brief Reserve room for entities and all their components
+     *
+     *  \param capacity The number of entities
+     */
+    void reserve(int capacity);
+
+    /**
+     *  \brief Create an Entity with no components
+     *
+     *  \return Entity of the new entity
+     *
+     *  \sa destroy()
+     */
+    Entity create();
+
+    /**
+     *  \brief Create many entities at once
+     *
+     *  \param entities The array to write the entities to
+     *  \param count The number of entities to create
+     */
+    void create(Entity* entities, int count);
+
+    /**
+     *  \brief Destroy an Entity and its components
+     *
+     *  \param entity The Entity to destroy
+     *
+     *  \sa create()
+     */
+    void destroy(Entity entity);
+
+    /**
+     *  \brief Destroy many entities at once
+     *
+     *  \param entities The entities to destroy
+     *  \param count The number of entities
+     */
+    void destroy(const Entity* entities, int count);
+
+    /**
+     *  \brief Destroy every Entity
+     */
+    void clear();
+
+    /**
+     *  \brief Check if an Entity has not been destroyed
+     *
+     *  \param entity The Entity to check
+     *
+     *  \return true if the Entity is alive
+     */
+    bool valid(Entity entity);
+
+    /**
+     *  \brief Get the number of living entities
+     *
+     *  \return int of the number of entities
+     */
+    int getCount();
+
+    /**
+     *  \brief Get the storage of a component type
+     *
+     *  \return SparseSet<T>* of the components
+     */
+    template<class T>
+    SparseSet<T>* getComponents();
+
+    /**
+     *  \brief Add a component to an Entity or replace the existing one
+     *
+     *  \param entity The Entity to add to
+     *  \param component The value of the component
+     *
+     *  \return T* of the stored component
+     */
+    template<class T>
+    T* add(Entity entity, const T& component) {
+      return getComponents<T>()->add(entity, component);
+    }
+
+    /**
+     *  \brief Add the same component to many entities
+     *
+     *  \param entities The entities to add to
+     *  \param count The number of entities
+     *  \param component The value of the component
+     */
+    template<class T>
+    void add(const Entity* entities, int count, const T& component) {
+      for(int i = 0; i < count; i++) {
+        add<T>(entities[i], component);
+      }
+    }
+
+    /**
+     *  \brief Remove a component from an Entity
+     *
+     *  \param entity The Entity to remove from
+     */
+    template<class T>
+    void remove(Entity entity) {
+      getComponents<T>()->remove(entity);
+    }
+
+    /**
+     *  \brief Get the component of an Entity
+     *
+     *  \param entity The Entity
+     *
+     *  \return T* of the component or NULL
+     */
+    template<class T>
+    T* get(Entity entity) {
+      return getComponents<T>()->get(entity);
+    }
+
+    /**
+     *  \brief Check if an Entity has a component
+     *
+     *  \param entity The Entity
+     *
+     *  \return true if the Entity has the component
+     */
+    template<class T>
+    bool has(Entity entity) {
+      return getComponents<T>()->has(entity);
+    }
+  };
+
+  template<> inline SparseSet<Transform>* Registry::getComponents<Transform>() { return &transforms; }
+  template<> inline SparseSet<Velocity>* Registry::getComponents<Velocity>() { return &velocities; }
+  template<> inline SparseSet<Layer>* Registry::getComponents<Layer>() { return &layers; }
+  template<> inline SparseSet<Renderable>* Registry::getComponents<Renderable>() { return &renderables; }
+  template<> inline SparseSet<Animated>* Registry::getComponents<Animated>() { return &animations; }
+
+  // Animated slots are owned by the entity, so adding clones the slot and
+  // removing frees it
+  template<> Animated* Registry::add<Animated>(Entity entity, const Animated& component);
+  template<> void Registry::remove<Animated>(Entity entity);
+}}
+
+#endif
@@ -0,0 +1,229 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file sparse_set.h
+ *
+ * A blackhole library container mapping entities to densely packed components
+ */
+
+#pragma once
+#ifndef ECS_SPARSE_SET_H
+#define ECS_SPARSE_SET_H
+
+#include <vector>
+#include <algorithm>
+#include "entity.h"
+
+namespace blackhole {
+namespace ecs {
+
+  /**
+   *  \brief Storage for one component type. The components are kept
+   *         packed in one array so systems walk them linearly, and a
+   *         sparse array indexed by entity finds a component in O(1).
+   *         Removing swaps the last component into the hole
+   */
+  template<class T>
+  class SparseSet {
+  private:
+    static constexpr Uint32 ABSENT = 0xFFFFFFFF;
+
+    std::vector<Uint32> sparse;
+    std::vector<Entity> entities;
+    std::vector<T> components;
+    std::vector<Uint32> order;
+
+    void grow(Uint32 index) {
+      if(index >= sparse.size()) {
+        sparse.resize(index + 1, ABSENT);
+      }
+    }
+  public:
+
+    /**
+     *  \brief Reserve room so adding up to count components does not
+     *         reallocate
+     *
+     *  \param count The number of components
+     *  \param maxEntities The number of entity indexes in the Registry
+     */
+    void reserve(int count, int maxEntities) {
+      entities.reserve(count);
+      components.reserve(count);
+      if((int)sparse.size() < maxEntities) {
+        sparse.resize(maxEntities, ABSENT);
+      }
+    }
+
+    /**
+     *  \brief Add a component or replace the existing one
+     *
+     *  \param entity The Entity to add to
+     *  \param component The value of the component
+     *
+     *  \return T* of the stored component
+     */
+    T* add(Entity entity, const T& component) {
+      Uint32 index = entityIndex(entity);
+      grow(index);
+      if(sparse[index] != ABSENT) {
+        entities[sparse[index]] = entity;
+        components[sparse[index]] = component;
+        return &components[sparse[index]];
+      }
+      sparse[index] = entities.size();
+      entities.push_back(entity);
+      components.push_back(component);
+      return &components.back();
+    }
+
+    /**
+     *  \brief Remove the component of an Entity if it has one
+     *
+     *  \param entity The Entity to remove from
+     */
+    void remove(Entity entity) {
+      if(!has(entity)) {
+        return;
+      }
+      Uint32 index = entityIndex(entity);
+      Uint32 slot = sparse[index];
+      Uint32 last = entities.size() - 1;
+      if(slot != last) {
+        entities[slot] = entities[last];
+        components[slot] = components[last];
+        sparse[entityIndex(entities[slot])] = slot;
+      }
+      entities.pop_back();
+      components.pop_back();
+      sparse[index] = ABSENT;
+    }
+
+    /**
+     *  \brief Check if an Entity has the component
+     *
+     *  \param entity The Entity to check
+     *
+     *  \return true if it has the component
+     */
+    bool has(Entity entity) {
+      Uint32 index = entityIndex(entity);
+      return index < sparse.size() && sparse[index] != ABSENT && entities[sparse[index]] == entity;
+    }
+
+    /**
+     *  \brief Get the component of an Entity
+     *
+     *  \param entity The Entity
+     *
+     *  \return T* of the component or NULL
+     */
+    T* get(Entity entity) {
+      if(!has(entity)) {
+        return NULL;
+      }
+      return &components[sparse[entityIndex(entity)]];
+    }
+
+    /**
+     *  \brief Sort the packed components. Systems walking the set then
+     *         visit them in this order
+     *
+     *  \param compare Returns true if the first Entity goes before the second
+     */
+    template<class Compare>
+    void sort(Compare compare) {
+      order.resize(entities.size());
+      for(Uint32 i = 0; i < order.size(); i++) {
+        order[i] = i;
+      }
+      std::stable_sort(order.begin(), order.end(), [&](Uint32 first, Uint32 second) {
+        return compare(entities[first], entities[second]);
+      });
+      // Walk each cycle of the permutation so no second copy of the
+      // components is needed
+      for(Uint32 i = 0; i < order.size(); i++) {
+        if(order[i] == i) {
+          continue;
+        }
+        Entity entity = entities[i];
+        T component = components[i];
+        Uint32 current = i;
+        while(order[current] != i) {
+          Uint32 next = order[current];
+          entities[current] = entities[next];
+          components[current] = components[next];
+          sparse[entityIndex(entities[current])] = current;
+          order[current] = current;
+          current = next;
+        }
+        entities[current] = entity;
+        components[current] = component;
+        sparse[entityIndex(entity)] = current;
+        order[current] = current;
+      }
+    }
+
+    /**
+     *  \brief Remove every component
+     */
+    void clear() {
+      for(Entity entity : entities) {
+        sparse[entityIndex(entity)] = ABSENT;
+      }
+      entities.clear();
+      components.clear();
+    }
+
+    /**
+     *  \brief Get the number of components
+     *
+     *  \return int of the number of components
+     */
+    int size() {
+      return entities.size();
+    }
+
+    /**
+     *  \brief Get the packed entities, in the same order as getComponents()
+     *
+     *  \return Entity* of the first Entity
+     */
+    Entity* getEntities() {
+      return entities.data();
+    }
+
+    /**
+     *  \brief Get the packed components
+     *
+     *  \return T* of the first component
+     */
+    T* getComponents() {
+      return components.data();
+    }
+  };
+}}
+
+#endif
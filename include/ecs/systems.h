@@ -0,0 +1,95 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file systems.h
+ *
+ * A blackhole library set of systems walking the components of an ecs::Registry
+ */
+
+#pragma once
+#ifndef ECS_SYSTEMS_H
+#define ECS_SYSTEMS_H
+
+#include <SDL2/SDL.h>
+#include "registry.h"
+#include "../jobs/thread_pool.h"
+#include "../graphics/frame_stats.h"
+
+namespace blackhole {
+namespace graphics {
+  class RenderCommandBuffer;
+}
+
+namespace ecs {
+
+  /**
+   *  \brief Move every entity with a Velocity and a Transform, split in
+   *         ranges of entities across a ThreadPool
+   *
+   *  \param registry The Registry to update
+   *  \param time The time passed in seconds
+   *  \param pool The ThreadPool to run on. NULL to run on the calling
+   *         thread
+   */
+  void integrate(Registry* registry, float time, jobs::ThreadPool* pool = NULL);
+
+  /**
+   *  \brief Order the Renderable components by Layer so drawRenderables()
+   *         draws lower layers first. Entities without a Layer are on 0.
+   *         Call it after changing layers, not every frame
+   *
+   *  \param registry The Registry to sort
+   */
+  void sortByLayer(Registry* registry);
+
+  /**
+   *  \brief Draw every entity with a Renderable and a Transform, in the
+   *         order of the Renderable components
+   *
+   *  \param registry The Registry to draw
+   *  \param renderer The renderer to draw to
+   *  \param viewports Only entities touching one of these are drawn
+   *  \param num_viewports The number of viewports. 0 draws everything
+   *  \param stats Not NULL to add the draws and culled entities to
+   */
+  void drawRenderables(Registry* registry, SDL_Renderer* renderer, const SDL_Rect* viewports = NULL, int num_viewports = 0, graphics::FrameStats* stats = NULL);
+
+  /**
+   *  \brief Record every entity with a Renderable and a Transform into a
+   *         RenderCommandBuffer, in the order of the Renderable
+   *         components. Unlike drawRenderables() nothing is drawn, so it
+   *         is used while a frame is recorded on the simulation thread
+   *
+   *  \param registry The Registry to record
+   *  \param commands The buffer to record into
+   *  \param layer The layer to draw the entities on
+   *  \param viewports Only entities touching one of these are recorded
+   *  \param num_viewports The number of viewports. 0 records everything
+   *  \param stats Not NULL to add the recorded and culled entities to
+   */
+  void recordRenderables(Registry* registry, graphics::RenderCommandBuffer* commands, int layer, const SDL_Rect* viewports = NULL, int num_viewports = 0, graphics::FrameStats* stats = NULL);
+}}
+
+#endif
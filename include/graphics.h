@@ -31,10 +31,28 @@
 
 #include "graphics/animator_controller.h"
 #include "graphics/animation.h"
+#include "graphics/animation_id.h"
+#include "graphics/animation_system.h"
 #include "graphics/color.h"
 #include "graphics/image.h"
+#include "graphics/render_cache.h"
+#include "graphics/render_command_buffer.h"
+#include "graphics/frame_pipeline.h"
+#include "graphics/frame_stats.h"
+#include "graphics/stats_overlay.h"
+#include "graphics/flight_recorder.h"
+#include "graphics/render_graph.h"
+#include "graphics/render_target_pool.h"
 #include "graphics/spritesheet.h"
+#include "graphics/sprite.h"
+#include "graphics/sprite_record.h"
+#include "graphics/sprite_atlas.h"
 #include "graphics/window.h"
 #include "graphics/tilemap.h"
 #include "graphics/text.h"
+#include "graphics/transform.h"
+#include "graphics/texture.h"
+#include "graphics/context.h"
+#include "graphics/world.h"
 #include "graphics/camera.h"
+#include "graphics/particle_emitter.h"
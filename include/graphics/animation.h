@@ -33,6 +33,7 @@
 #define ANIMATION_H
 
 #include "spritesheet.h"
+#include "animation_system.h"
 #include "imageBase.h"
 #include <iostream>
 #include <stdio.h>
@@ -42,31 +43,41 @@ namespace graphics {
 
   /**
    *  \brief The class for looping through SpriteSheet frames
-   *         built on ImageBase
+   *         built on ImageBase. The frame state lives in an AnimationSystem
+   *         and the Animation is a handle to it. The SpriteSheet is only
+   *         read so many Animation can share one
    */
   class Animation : public ImageBase {
   private:
-    SpriteSheet* images;
-    int* frames;
-    int num_frames;
-    float speed;
-    float time = 0;
+    AnimationSystem* system;
+    int id;
+
+    float x;
+    float y;
+
+    void updateRecord();
   public:
 
     /**
      *  \brief Constructor of Animation.
      *
-     *  \param images The pointer to the SpriteSheet used for frames
+     *  \param images The pointer to the SpriteSheet used for frames. The
+     *                Animation starts at the SpriteSheet position
      *  \param frame The starting frame
      *  \param frames The order of frames for the animation eg. 0, 2, 1, 2
      *  \param num_frames The number of frames in the animation eg. 4
-     *  \param speed The amount of time between frames
+     *  \param speed The amount of time between frames. 0 to use the
+     *         duration of each SpriteSheet frame
+     *  \param system The AnimationSystem that advances the Animation.
+     *                NULL for the default system
      */
-    Animation(SpriteSheet* images, int frame, int* frames, int num_frames, float speed = 1);
+    Animation(SpriteSheet* images, int frame, int* frames, int num_frames, float speed = 1, AnimationSystem* system = NULL);
+    Animation(const Animation& animation);
+    Animation& operator=(const Animation& animation);
     ~Animation();
 
     /**
-     *  \brief Set the x position of the Animation SpriteSheet
+     *  \brief Set the x position of the Animation
      *
      *  \param x The x position you want the sprite to render on
      *
@@ -77,7 +88,7 @@ namespace graphics {
     void setX(float x);
 
     /**
-     *  \brief Set the y position of the Animation SpriteSheet
+     *  \brief Set the y position of the Animation
      *
      *  \param y the y position you want the sprite to render on
      *
@@ -88,7 +99,7 @@ namespace graphics {
     void setY(float y);
 
     /**
-     *  \brief Get the x position of the Animation SpriteSheet
+     *  \brief Get the x position of the Animation
      *
      *  \sa setX()
      *  \sa setY()
@@ -97,7 +108,7 @@ namespace graphics {
     float getX();
 
     /**
-     *  \brief Get the y position of the Animation SpriteSheet
+     *  \brief Get the y position of the Animation
      *
      *  \sa setY()
      *  \sa setX()
@@ -138,22 +149,27 @@ namespace graphics {
     void resetAnimation();
 
 
+
     /**
-     *  \brief add the amount of time passed so that the Animation
-     *         can update.
+     *  \brief Get a pointer to the SpriteSheet
      *
-     *  \param time The amount of time passed in the frame
+     *  \return SpriteSheet* of Animation SpriteSheet
      */
-    void addTime(float time);
-
+    SpriteSheet* getSpriteSheet();
 
+    /**
+     *  \brief Get the AnimationSystem that advances the Animation
+     *
+     *  \return AnimationSystem* of the Animation
+     */
+    AnimationSystem* getAnimationSystem();
 
     /**
-     *  \brief Get a pointer to the SpriteSheet
+     *  \brief Get the slot of the Animation in its AnimationSystem
      *
-     *  \return SpriteSheet* of Animation SpriteSheet
+     *  \return int id of the slot
      */
-    SpriteSheet* getSpriteSheet();
+    int getSlot();
 
     /**
      *  \brief Get a pointer to the SpriteSheet texture
@@ -168,7 +184,7 @@ namespace graphics {
      *  \brief Get a pointer to the destination rect used for positioning
      *         with the renderer
      *
-     *  \return SDL_Rect* destRect of SpriteSheet
+     *  \return SDL_Rect* destRect of Animation
      */
     SDL_Rect* getDestRect();
 
@@ -176,7 +192,7 @@ namespace graphics {
      *  \brief Get a pointer to the source rect used for getting the frame
      *         of the SpriteSheet
      *
-     *  \return SDL_Rect* srcRect of SpriteSheet
+     *  \return SDL_Rect* srcRect of the current frame
      */
     SDL_Rect* getSrcRect();
   
@@ -0,0 +1,70 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file animation_id.h
+ *
+ * A blackhole library hash for naming animations and parameters
+ */
+
+#pragma once
+#ifndef ANIMATION_ID_H
+#define ANIMATION_ID_H
+
+#include <SDL2/SDL.h>
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief The interned name of an animation state or parameter
+   */
+  typedef Uint32 AnimationId;
+
+  /**
+   *  \brief The AnimationId matching every state in
+   *         AnimatorController::addTransition()
+   */
+  const AnimationId ANY_ANIMATION = 0;
+
+  /**
+   *  \brief Hash a name into an AnimationId. Evaluated at compile time
+   *         when given a string literal
+   *
+   *  \param name The name to hash eg. running
+   *
+   *  \return AnimationId of the name
+   */
+  constexpr AnimationId animationId(const char* name) {
+    // 32 bit FNV-1a
+    AnimationId hash = 2166136261u;
+    for(; *name != '\0'; name++) {
+      hash ^= (Uint8)*name;
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+}}
+
+#endif
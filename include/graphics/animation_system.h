@@ -0,0 +1,287 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file animation_system.h
+ *
+ * A blackhole library class for advancing every Animation in one pass
+ */
+
+#pragma once
+#ifndef ANIMATION_SYSTEM_H
+#define ANIMATION_SYSTEM_H
+
+#include "spritesheet.h"
+#include "sprite_record.h"
+#include <SDL2/SDL.h>
+#include <vector>
+
+namespace blackhole {
+namespace graphics {
+
+  class AnimatorController;
+
+  /**
+   *  \brief The class that stores the state of every Animation in
+   *         structure-of-arrays form against one shared clock
+   *
+   *  Each Animation is a handle to one slot of the system. The slot keeps
+   *  the clock time it started at, its speed and its frame-table offset in
+   *  flat arrays. update() only advances the clock and evaluates the
+   *  transitions of every AnimatorController, so an Animation that is never
+   *  drawn costs nothing. The frame is worked out from the clock the first
+   *  time it is read in a tick, or for every slot at once in a vectorized
+   *  pass with evaluateAll().
+   */
+  class AnimationSystem {
+  private:
+    struct FrameRange {
+      int offset;
+      int count;
+    };
+
+    double clock = 0;
+    Uint32 tick = 0;
+
+    std::vector<double> start;
+    std::vector<float> speed;
+    std::vector<float> inverseSpeed;
+    std::vector<double> duration;
+    std::vector<double> inverseDuration;
+    std::vector<int> frameOffset;
+    std::vector<int> frameCount;
+    std::vector<Uint32> evaluated;
+    std::vector<float> elapsed;
+    std::vector<int> step;
+    std::vector<int> frame;
+    std::vector<SDL_Rect> srcRect;
+    std::vector<SDL_Point> destOffset;
+
+    std::vector<int> frameTable;
+    std::vector<SDL_Rect> frameRects;
+    std::vector<SDL_Point> frameDestOffsets;
+    std::vector<float> frameEnds;
+    std::vector<SpriteSheet*> sheets;
+
+    std::vector<int> freeSlots;
+    std::vector<int> rangeUsers;
+    std::vector<FrameRange> freeRanges;
+
+    std::vector<AnimatorController*> controllers;
+
+    int allocate();
+    int allocateFrames(int count);
+    void releaseFrames(int offset, int count);
+    void setTiming(int id, float speed, float duration);
+    void gather(int id);
+  public:
+    AnimationSystem();
+    ~AnimationSystem();
+
+    /**
+     *  \brief Get the AnimationSystem used by every Animation that was
+     *         not given one. That is the one of the World current on the
+     *         calling thread. Without a World an error is printed and one
+     *         shared system is returned, which only advances if update()
+     *         is called on it
+     *
+     *  \return AnimationSystem* of the default system
+     *
+     *  \sa World::makeCurrent()
+     */
+    static AnimationSystem* getDefault();
+
+    /**
+     *  \brief Create a slot for an animation
+     *
+     *  \param sheet The SpriteSheet the frames are taken from
+     *  \param frames The order of frames for the animation eg. 0, 2, 1, 2
+     *  \param num_frames The number of frames in the animation eg. 4
+     *  \param speed The amount of time between frames. 0 to use the
+     *         duration of each SpriteSheet frame
+     *  \param frame The starting frame
+     *
+     *  \return int id of the slot
+     *
+     *  \sa destroy()
+     */
+    int create(SpriteSheet* sheet, const int* frames, int num_frames, float speed, int frame);
+
+    /**
+     *  \brief Create a new slot with the same state as another
+     *
+     *  \param id The slot to copy
+     *
+     *  \return int id of the new slot
+     */
+    int clone(int id);
+
+    /**
+     *  \brief Free a slot so it can be reused
+     *
+     *  \param id The slot to free
+     *
+     *  \sa create()
+     */
+    void destroy(int id);
+
+    /**
+     *  \brief Evaluate the transitions of an AnimatorController every update()
+     *
+     *  \param controller The AnimatorController to add
+     *
+     *  \sa removeController()
+     */
+    void addController(AnimatorController* controller);
+
+    /**
+     *  \brief Stop evaluating an AnimatorController
+     *
+     *  \param controller The AnimatorController to remove
+     *
+     *  \sa addController()
+     */
+    void removeController(AnimatorController* controller);
+
+    /**
+     *  \brief Advance the clock by the time passed in the frame then
+     *         evaluate every AnimatorController
+     *
+     *  \param time The amount of time passed in the frame
+     *
+     *  \sa getClock()
+     */
+    void update(float time);
+
+    /**
+     *  \brief Get the time every animation is played against
+     *
+     *  \return double of seconds since the system was created
+     *
+     *  \sa update()
+     */
+    double getClock();
+
+    /**
+     *  \brief Work out the frame of one animation from the clock. Does
+     *         nothing if it was already worked out this tick
+     *
+     *  \param id The slot to evaluate
+     *
+     *  \sa evaluateAll()
+     */
+    void evaluate(int id);
+
+    /**
+     *  \brief Work out the frame of every animation in one vectorized pass.
+     *         Faster than evaluate() when most animations are drawn
+     *
+     *  \sa evaluate()
+     */
+    void evaluateAll();
+
+    /**
+     *  \brief Evaluate a slot and write its frame into a SpriteRecord
+     *
+     *  \param id The slot to evaluate
+     *  \param record The SpriteRecord to write the src and dest rect to
+     */
+    void resolve(int id, SpriteRecord* record);
+
+    /**
+     *  \brief Start an animation again from the current clock time
+     *
+     *  \param id The slot to reset
+     */
+    void reset(int id);
+
+    /**
+     *  \brief Show a frame of the SpriteSheet until the next update()
+     *
+     *  \param id The slot to change
+     *  \param frame The SpriteSheet frame to show
+     *
+     *  \sa getFrame()
+     */
+    void setFrame(int id, int frame);
+
+    /**
+     *  \brief Get the SpriteSheet frame an animation is showing
+     *
+     *  \param id The slot to read
+     *
+     *  \return int of the frame eg. 0
+     *
+     *  \sa setFrame()
+     */
+    int getFrame(int id);
+
+    /**
+     *  \brief Get the SpriteSheet an animation takes its frames from
+     *
+     *  \param id The slot to read
+     *
+     *  \return SpriteSheet* of the slot
+     */
+    SpriteSheet* getSpriteSheet(int id);
+
+    /**
+     *  \brief Get a pointer to the source rect of the current frame
+     *
+     *  \param id The slot to read
+     *
+     *  \return SDL_Rect* srcRect of the slot
+     */
+    SDL_Rect* getSrcRect(int id);
+
+    /**
+     *  \brief Get a pointer to the source rect the last time the slot was
+     *         evaluated without evaluating it again
+     *
+     *  \param id The slot to read
+     *
+     *  \return SDL_Rect* srcRect of the slot
+     */
+    SDL_Rect* getLastSrcRect(int id);
+
+    /**
+     *  \brief Get where the frame is drawn from the animation position the
+     *         last time the slot was evaluated. Not {0, 0} for trimmed frames
+     *
+     *  \param id The slot to read
+     *
+     *  \return SDL_Point* destOffset of the slot
+     */
+    SDL_Point* getDestOffset(int id);
+
+    /**
+     *  \brief Get the amount of slots, including freed ones
+     *
+     *  \return int of the slot count
+     */
+    int getSize();
+  };
+}}
+
+#endif
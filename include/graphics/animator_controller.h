@@ -33,9 +33,12 @@
 #define ANIMATOR_CONTROLLER_H
 
 #include "animation.h"
+#include "animation_id.h"
 #include "imageBase.h"
 #include <iostream>
 #include <stdio.h>
+#include <unordered_map>
+#include <vector>
 
 namespace blackhole {
 namespace graphics {
@@ -50,7 +53,30 @@ namespace graphics {
   };
 
   /**
-   *  \brief The class for holding and controlling Animation
+   *  \brief How an AnimatorTransition compares its parameter
+   */
+  enum AnimatorCondition {
+    ANIMATOR_GREATER,    /**< parameter > value */
+    ANIMATOR_LESS,       /**< parameter < value */
+    ANIMATOR_EQUAL,      /**< parameter == value */
+    ANIMATOR_NOT_EQUAL   /**< parameter != value */
+  };
+
+  /**
+   *  \brief A rule for switching from one Animation to another
+   */
+  struct AnimatorTransition {
+    int to;                       /**< The state to switch to */
+    int parameter;                /**< The parameter slot to compare */
+    AnimatorCondition condition;  /**< How the parameter is compared */
+    float value;                  /**< The value to compare against */
+  };
+
+  /**
+   *  \brief The class for holding and controlling Animation. The states
+   *         are looked up by AnimationId so switching is O(1), and the
+   *         transitions are evaluated once per tick by the AnimationSystem
+   *         of the first Animation
    */
   class AnimatorController : public ImageBase {
   private:
@@ -62,6 +88,20 @@ namespace graphics {
     animation_holder* animations;
     Animation* currentAnimation;
     const char* currentAnimationName;
+    int currentState;
+
+    std::unordered_map<AnimationId, int> states;
+    std::unordered_map<AnimationId, int> parameterSlots;
+    std::vector<float> parameters;
+    std::vector<std::vector<AnimatorTransition>> transitions;
+    std::vector<AnimatorTransition> anyTransitions;
+
+    AnimationSystem* system;
+
+    void setState(int state);
+    void updateRecord();
+    int getParameterSlot(AnimationId parameter);
+    bool check(const AnimatorTransition& transition);
   public:
 
     /**
@@ -71,6 +111,7 @@ namespace graphics {
      *  \param array_length The amount of Animation
      */
     AnimatorController(animation_holder* animations, long int array_length);
+    AnimatorController(const AnimatorController& controller);
     ~AnimatorController();
 
     /**
@@ -83,6 +124,17 @@ namespace graphics {
      */
     void setAnimation(const char* animation);
 
+    /**
+     *  \brief Set the Animation to be displayed
+     *
+     *  \param animation The AnimationId of the Animation to display
+     *         eg. animationId("running")
+     *
+     *  \sa getAnimation()
+     *  \sa getAnimationName()
+     */
+    void setAnimation(AnimationId animation);
+
     /**
      *  \brief Get the Animation that is being displayed
      *
@@ -105,6 +157,50 @@ namespace graphics {
 
 
 
+    /**
+     *  \brief Set a parameter used by the transitions eg. speed or grounded
+     *
+     *  \param parameter The AnimationId of the parameter
+     *  \param value The new value. Use 0 and 1 for true and false
+     *
+     *  \sa getParameter()
+     *  \sa addTransition()
+     */
+    void setParameter(AnimationId parameter, float value);
+
+    /**
+     *  \brief Get a parameter used by the transitions
+     *
+     *  \param parameter The AnimationId of the parameter
+     *
+     *  \return float of the value. 0 if it was never set
+     *
+     *  \sa setParameter()
+     */
+    float getParameter(AnimationId parameter);
+
+    /**
+     *  \brief Add a rule for switching Animation when a parameter changes
+     *
+     *  \param from The AnimationId of the state the rule applies in.
+     *         ANY_ANIMATION for every state
+     *  \param to The AnimationId of the state to switch to
+     *  \param parameter The AnimationId of the parameter to compare
+     *  \param condition How the parameter is compared
+     *  \param value The value the parameter is compared against
+     *
+     *  \sa evaluate()
+     */
+    void addTransition(AnimationId from, AnimationId to, AnimationId parameter, AnimatorCondition condition, float value);
+
+    /**
+     *  \brief Switch to the first state whose transition passes. Called
+     *         once per tick by the AnimationSystem
+     */
+    void evaluate();
+
+
+
     /**
      *  \brief Set the x position of the Animation being displayed
      *
@@ -147,16 +243,6 @@ namespace graphics {
 
 
 
-    /**
-     *  \brief add the amount of time passed so that the Animation
-     *         can update.
-     *
-     *  \param time The amount of time passed in the frame
-     */
-    void addTime(float time);
-
-
-    
     /**
      *  \brief Get a pointer to the Animation texture
      *
@@ -34,6 +34,7 @@
 
 #include "imageBase.h"
 #include "imageHolder.h"
+#include "render_cache.h"
 #include <iostream>
 #include <list>
 
@@ -41,7 +42,9 @@ namespace blackhole {
 namespace graphics {
 
   /**
-   *  \brief The class for viewing classes built on ImageBase
+   *  \brief The class for viewing classes built on ImageBase. The view
+   *         position is kept in floats so the Camera can scroll by less
+   *         than a pixel
    */
   class Camera : public ImageBase {
   private:
@@ -51,6 +54,10 @@ namespace graphics {
     std::list<ImageHolder> renderQueue;
 
     SDL_Renderer* renderer;
+    RenderCache* cache;
+    Uint32 id;
+
+    void updateViewport();
   public:
     /**
      *  \brief The Constructor of Camera
@@ -58,21 +65,13 @@ namespace graphics {
      *  \param renderer The renderer of the Window
      *  \param w The width of the Camera
      *  \param h The height of the Camera
-     *  \param x The x position of the Camera
-     *  \param y the y position of the Camera
+     *  \param x The x position of the Camera on the Window
+     *  \param y the y position of the Camera on the Window
      */
     Camera(SDL_Renderer* renderer, int w, int h, float x = 0, float y = 0);
     ~Camera();
 
 
-    /**
-     *  \brief adjusts time for the images when Camera is used as 
-     *         an image collator
-     *
-     *  \param time The amount of time passed in the frame
-     */
-    void addTime(float time);
-    
     /**
      *  \brief Set the x position of the Camera
      *
@@ -91,6 +90,24 @@ namespace graphics {
      */
     void setY(float y);
 
+    /**
+     *  \brief Get the x position the Camera views
+     *
+     *  \return float of the x position
+     *
+     *  \sa setX()
+     */
+    float getX();
+
+    /**
+     *  \brief Get the y position the Camera views
+     *
+     *  \return float of the y position
+     *
+     *  \sa setY()
+     */
+    float getY();
+
 
     /**
      *  \brief Add an ImageBase based class to the Camera for collating.
@@ -114,25 +131,58 @@ namespace graphics {
 
 
     /**
-     *  \brief Get the size of the Camera viewport
+     *  \brief Get the whole pixels of the world the Camera views
      *
-     *  \return SDL_Rect* containing the size of the viewport
+     *  \return SDL_Rect* containing the position and size of the viewport
      */
     SDL_Rect* getViewport();
 
     /**
-     *  \brief Get the texture of the Camera for copying renderer
+     *  \brief Get the texture of the Camera with its images. The images
+     *         are kept in a RenderCache so only the regions where one was
+     *         added, removed, moved or changed frame are drawn again, and
+     *         nothing is drawn when called again with no changes. The
+     *         RenderCache is only made by the first call
      *
-     *  \return SDL_Texture* to be erased and copied over for the main renderer
+     *  \return SDL_Texture* to be copied to the main renderer
      */
-    SDL_Texture* getCamTexture();
+    SDL_Texture* getTexture();
 
     /**
-     *  \brief Get the texture of the Camera with its images
+     *  \brief Get a number that changes every time the texture from
+     *         getTexture() is drawn again
      *
-     *  \return SDL_Texture* to be copied to the main renderer
+     *  \return Uint32 of the version. 0 before the first getTexture()
      */
-    SDL_Texture* getTexture();
+    Uint32 getVersion();
+
+    /**
+     *  \brief Get the number the Window keys the RenderCache of a Camera
+     *         added as an image by. No two Cameras share one
+     *
+     *  \return Uint32 of the id
+     */
+    Uint32 getId();
+
+    /**
+     *  \brief Record the images of the Camera in order, for a RenderCache
+     *         to draw. Called by Window when the Camera is added to it as
+     *         an image, which then draws the cache on the render thread
+     *
+     *  \param commands The buffer to record into
+     */
+    void recordImages(RenderCommandBuffer* commands);
+
+    /**
+     *  \brief Records nothing. getTexture() draws with the renderer, which
+     *         the thread recording a frame must not use. Window records a
+     *         Camera added to it as an image with recordImages() instead,
+     *         but one inside another Camera is not drawn
+     *
+     *  \param commands The buffer of the frame
+     *  \param layer The layer to draw on
+     */
+    void recordDraw(RenderCommandBuffer* commands, int layer);
   };
 }}
 
@@ -0,0 +1,82 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file context.h
+ *
+ * A blackhole library class sharing the SDL subsystems between instances
+ */
+
+#pragma once
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include <SDL2/SDL.h>
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief A reference to the SDL subsystems, which exist once per
+   *         process. Subsystems are started by the first Context asking
+   *         for them and SDL is only shut down with the last Context, so
+   *         any number of Windows and Worlds can live on any threads
+   */
+  class Context {
+  private:
+    Uint32 flags;
+    bool valid;
+  public:
+
+    /**
+     *  \brief Start the SDL subsystems if no Context has yet
+     *
+     *  \param flags The SDL_INIT_* subsystems eg. SDL_INIT_VIDEO
+     */
+    Context(Uint32 flags);
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+
+    /**
+     *  \brief Release the subsystems, quitting SDL after the last Context
+     */
+    ~Context();
+
+    /**
+     *  \brief Check if the subsystems started
+     *
+     *  \return true if SDL is usable
+     */
+    bool isValid();
+
+    /**
+     *  \brief Get the number of live Contexts in the process
+     *
+     *  \return int of the number of Contexts
+     */
+    static int getCount();
+  };
+}}
+
+#endif
@@ -0,0 +1,241 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file flight_recorder.h
+ *
+ * A blackhole library class for capturing the timings around slow frames
+ */
+
+#pragma once
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief Rings of the most recent timed events of every thread, eg.
+   *         the phases of each frame, asset loads and texture creations.
+   *         Recording is always on and cheap, as each thread records into
+   *         a ring of its own. Events are tagged with the instance and
+   *         frame their thread works on, so Windows sharing the recorder
+   *         keep their frames apart. When a frame takes longer than the
+   *         capture budget the last seconds of events are saved as a
+   *         Chrome trace, which can be opened in chrome://tracing or
+   *         Perfetto
+   */
+  class FlightRecorder {
+  private:
+    struct Event {
+      const char* name;
+      char detail[40];
+      Uint64 start;
+      Uint64 end;
+      Uint64 frame;
+      Uint32 thread;
+      Uint32 instance;
+    };
+
+    // Only the thread using it records into a buffer, copies of the
+    // events are all that wait on its lock
+    struct ThreadBuffer {
+      std::mutex mutex;
+      std::vector<Event> events;
+      size_t next;
+      size_t count;
+      std::atomic<bool> used;
+    };
+
+    Uint32 id;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    int capacity;
+    std::mutex mutex;
+    std::atomic<bool> enabled;
+    float budget;
+    float seconds;
+    std::string prefix;
+    std::unordered_map<Uint32, Uint64> lastCaptures;
+    int captures;
+    std::atomic<int> writing;
+
+    static Uint32 getThreadId();
+    ThreadBuffer* getBuffer();
+    void copy(std::vector<Event>* out, float seconds, bool all, Uint32 instance);
+    static bool write(const char* file, const std::vector<Event>& events);
+  public:
+
+    /**
+     *  \brief The constructor of FlightRecorder
+     *
+     *  \param capacity The number of events to keep for each thread
+     */
+    FlightRecorder(int capacity = 4096);
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    /**
+     *  \brief Waits for captures still being written
+     */
+    ~FlightRecorder();
+
+    /**
+     *  \brief Get the recorder shared by the library
+     *
+     *  \return FlightRecorder* of the default recorder
+     */
+    static FlightRecorder* getDefault();
+
+    /**
+     *  \brief Turn recording on or off. On by default
+     *
+     *  \param enabled true to record
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     *  \brief Check if events are being recorded
+     *
+     *  \return true if recording
+     */
+    bool isEnabled();
+
+    /**
+     *  \brief Forget every event and keep a different number from now on
+     *
+     *  \param capacity The number of events to keep for each thread
+     */
+    void setCapacity(int capacity);
+
+    /**
+     *  \brief Tag the events the calling thread records from now on,
+     *         in every recorder. Set by Window on its threads, other
+     *         threads such as the ThreadPool record with instance 0
+     *
+     *  \param instance The instance the thread works for, eg. a Window.
+     *         0 for none
+     *  \param frame The number of the frame the thread works on
+     */
+    static void setThreadFrame(Uint32 instance, Uint64 frame);
+
+    /**
+     *  \brief Record an event from a start time until now
+     *
+     *  \param name The name of the event. Must outlive the recorder, eg.
+     *         a string literal
+     *  \param start SDL_GetPerformanceCounter() when the event began
+     *  \param detail Text saved with the event, eg. a file name. Only
+     *         the last 39 characters are kept. NULL for none
+     *
+     *  \return Uint64 of SDL_GetPerformanceCounter() at the end, to start
+     *          the next event with
+     */
+    Uint64 record(const char* name, Uint64 start, const char* detail = NULL);
+
+    /**
+     *  \brief Mark the end of a frame, capturing the last seconds of
+     *         events if it was over budget. A capture holds the events of
+     *         the instance of the calling thread and of instance 0. The
+     *         events are copied here and written by the default
+     *         ThreadPool. Called by Window
+     *
+     *  \param frame The number of the frame
+     *  \param frameTime The time of the frame in milliseconds
+     */
+    void endFrame(Uint64 frame, float frameTime);
+
+    /**
+     *  \brief Capture events when a frame is slow. After a capture the
+     *         next of the same instance is at least the seconds later, so
+     *         one hitch makes one capture
+     *
+     *  \param budget The frame time in milliseconds to capture over. 0
+     *         to never capture
+     *  \param seconds The seconds of events before the frame to save
+     *  \param prefix The start of the path of the captures. The
+     *         instance if not 0, the frame number and .json are added
+     */
+    void setCapture(float budget, float seconds = 3, const char* prefix = "hitch_");
+
+    /**
+     *  \brief Wait for the captures of slow frames to be written
+     */
+    void wait();
+
+    /**
+     *  \brief Save the recorded events of every instance as a Chrome
+     *         trace on the calling thread, each instance as a process
+     *
+     *  \param file The path to write to
+     *  \param seconds The seconds of events to save. 0 for all of them
+     *
+     *  \return true on success
+     */
+    bool dump(const char* file, float seconds = 0);
+
+    /**
+     *  \brief Get the number of captures made for slow frames
+     *
+     *  \return int of the number of captures
+     */
+    int getCaptureCount();
+  };
+
+  /**
+   *  \brief Records an event in the default FlightRecorder from its
+   *         construction until it goes out of scope
+   */
+  class FlightScope {
+  private:
+    const char* name;
+    const char* detail;
+    Uint64 start;
+  public:
+
+    /**
+     *  \brief Start timing an event
+     *
+     *  \param name The name of the event, eg. a string literal
+     *  \param detail Text saved with the event. NULL for none
+     */
+    FlightScope(const char* name, const char* detail = NULL);
+    FlightScope(const FlightScope&) = delete;
+    FlightScope& operator=(const FlightScope&) = delete;
+
+    /**
+     *  \brief Record the event
+     */
+    ~FlightScope();
+  };
+}}
+
+#endif
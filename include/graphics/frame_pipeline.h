@@ -0,0 +1,210 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file frame_pipeline.h
+ *
+ * A blackhole library class for handing frames from the simulation to the renderer
+ */
+
+#pragma once
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "render_command_buffer.h"
+#include "frame_stats.h"
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief A Camera as it was when a Frame was built, so the render
+   *         thread never reads a Camera that may have moved or been
+   *         destroyed since
+   */
+  struct FrameCamera {
+    SDL_FPoint view;  /**< The view position */
+    SDL_Rect dest;  /**< Where the Camera is drawn on the Window */
+    SDL_Rect src;  /**< The part of the Camera drawn */
+    bool hasSrc;  /**< false to draw the whole Camera */
+    SDL_RendererFlip flip;  /**< The flip the world is drawn with */
+  };
+
+  /**
+   *  \brief A Camera added to the World as an image. Its images are
+   *         recorded with the frame and the render thread keeps them in a
+   *         RenderCache of its own, keyed by the id of the Camera
+   */
+  struct FrameCollator {
+    Uint32 id;  /**< Camera::getId() */
+    SDL_Point size;  /**< The size of the Camera */
+    int command;  /**< The command in Frame::commands that draws the cache */
+  };
+
+  /**
+   *  \brief Everything the render thread needs to draw one simulated
+   *         frame. It is all copied out of the World while the frame is
+   *         recorded, so the simulation can change the World while the
+   *         frame is drawn
+   */
+  struct Frame {
+    Uint64 index;  /**< The number of the frame, counting from 0 */
+    Uint64 start;  /**< SDL_GetPerformanceCounter() when it was begun */
+    RenderCommandBuffer commands;  /**< The draws of the world */
+    std::vector<FrameCamera> cameras;  /**< The cameras in layer order */
+    std::vector<SDL_Rect> viewports;  /**< The viewports of the cameras */
+    std::vector<int> staticLayers;  /**< The layers kept in a RenderCache, in order */
+    std::vector<std::unique_ptr<RenderCommandBuffer>> staticCommands;  /**< The draws of each static layer */
+    std::vector<FrameCollator> collators;  /**< The cameras drawn as images */
+    std::vector<std::unique_ptr<RenderCommandBuffer>> collatorCommands;  /**< The draws of each collator */
+    SDL_Rect renderFrame;  /**< The area of the world drawn */
+    FrameStats stats;  /**< Filled in by both threads as the frame is made */
+  };
+
+  /**
+   *  \brief Frames passed from the simulation thread to the render
+   *         thread. The simulation writes frame N+1 while frame N is
+   *         drawn, and blocks once the render thread is the maximum
+   *         number of frames behind, so the latency between simulating
+   *         and showing a frame is bounded. Frames are drawn in the order
+   *         they were written
+   */
+  class FramePipeline {
+  private:
+    std::vector<std::unique_ptr<Frame>> frames;
+    std::deque<Frame*> free;
+    std::deque<Frame*> queued;
+    Frame* writing;
+    Frame* reading;
+    int maxFramesInFlight;
+    Uint64 nextIndex;
+    Uint64 readIndex;
+    bool closed;
+    std::vector<std::pair<Uint64, SDL_Texture*>> released;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::atomic<float> latency;
+  public:
+
+    /**
+     *  \brief The constructor of FramePipeline
+     *
+     *  \param maxFramesInFlight The number of written frames that may wait
+     *         to be drawn. 1 gives triple buffering, one frame drawn, one
+     *         waiting and one written
+     */
+    FramePipeline(int maxFramesInFlight = 1);
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    /**
+     *  \brief Get a frame to write, waiting while the maximum number of
+     *         frames are in flight
+     *
+     *  \return Frame* to write, NULL once closed
+     *
+     *  \sa endWrite()
+     */
+    Frame* beginWrite();
+
+    /**
+     *  \brief Queue the frame from beginWrite() to be drawn
+     */
+    void endWrite();
+
+    /**
+     *  \brief Get the oldest written frame to draw
+     *
+     *  \param timeout Milliseconds to wait for one
+     *
+     *  \return Frame* to draw, NULL if none was written in time
+     *
+     *  \sa endRead()
+     */
+    Frame* beginRead(int timeout);
+
+    /**
+     *  \brief Give back the frame from beginRead() once it is drawn
+     */
+    void endRead();
+
+    /**
+     *  \brief Wake and stop any thread waiting to write
+     */
+    void close();
+
+    /**
+     *  \brief Destroy a texture once every frame written before now has
+     *         been drawn, as those may still draw it. The render thread
+     *         destroys it in endRead(). From any thread
+     *
+     *  \param texture The texture no longer used by the simulation
+     */
+    void releaseTexture(SDL_Texture* texture);
+
+    /**
+     *  \brief Destroy every released texture straight away. Only once no
+     *         frame will be drawn again, before the renderer is destroyed
+     */
+    void destroyReleased();
+
+    /**
+     *  \brief Set the number of written frames that may wait to be drawn
+     *
+     *  \param maxFramesInFlight At least 1
+     */
+    void setMaxFramesInFlight(int maxFramesInFlight);
+
+    /**
+     *  \brief Get the number of written frames that may wait to be drawn
+     *
+     *  \return int of the maximum frames in flight
+     */
+    int getMaxFramesInFlight();
+
+    /**
+     *  \brief Get the number of written frames waiting to be drawn
+     *
+     *  \return int of the frames in flight
+     */
+    int getFramesInFlight();
+
+    /**
+     *  \brief Get the time from beginning the last drawn frame to the end
+     *         of drawing it
+     *
+     *  \return float of the latency in milliseconds
+     */
+    float getLatency();
+  };
+}}
+
+#endif
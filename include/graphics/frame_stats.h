@@ -0,0 +1,156 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file frame_stats.h
+ *
+ * A blackhole library class for keeping the render statistics of recent frames
+ */
+
+#pragma once
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <SDL2/SDL.h>
+#include <mutex>
+#include <vector>
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief The counters and timings of one frame
+   */
+  struct FrameStats {
+    Uint64 index;          /**< The number of the frame */
+    float frameTime;       /**< Milliseconds since the last frame was shown */
+    float updateTime;      /**< Milliseconds simulating and recording it */
+    float renderTime;      /**< Milliseconds drawing and presenting it */
+    int drawCalls;         /**< Texture copies and custom draws */
+    int textureBinds;      /**< Draws using a different texture to the last */
+    int drawn;             /**< Images recorded to be drawn */
+    int culled;            /**< Images outside every camera */
+    int targetSwitches;    /**< Changes of render target */
+    Uint64 textureMemory;  /**< Estimated bytes of the World's textures, see getTextureMemory() */
+  };
+
+  /**
+   *  \brief The FrameStats of the last frames, oldest overwritten first.
+   *         Frames are added by the render thread and may be read from
+   *         any thread
+   */
+  class FrameStatsRing {
+  private:
+    std::vector<FrameStats> frames;
+    std::vector<float> scratch;
+    size_t next;
+    size_t count;
+    std::mutex mutex;
+
+    float percentile(float FrameStats::*field, float percentile);
+  public:
+
+    /**
+     *  \brief The constructor of FrameStatsRing
+     *
+     *  \param capacity The number of frames to keep
+     */
+    FrameStatsRing(int capacity = 240);
+    FrameStatsRing(const FrameStatsRing&) = delete;
+    FrameStatsRing& operator=(const FrameStatsRing&) = delete;
+
+    /**
+     *  \brief Add a frame, replacing the oldest once full
+     *
+     *  \param stats The stats of the frame
+     */
+    void push(const FrameStats& stats);
+
+    /**
+     *  \brief Forget every frame and keep a different number from now on
+     *
+     *  \param capacity The number of frames to keep
+     */
+    void setCapacity(int capacity);
+
+    /**
+     *  \brief Get the number of frames that can be kept
+     *
+     *  \return int of the capacity
+     */
+    int getCapacity();
+
+    /**
+     *  \brief Get the number of frames kept
+     *
+     *  \return int of the number of frames
+     */
+    int getCount();
+
+    /**
+     *  \brief Get the newest frame
+     *
+     *  \param stats Set to the frame
+     *
+     *  \return false if there are no frames yet
+     */
+    bool getLatest(FrameStats* stats);
+
+    /**
+     *  \brief Copy the frames kept, oldest first
+     *
+     *  \param stats Replaced with the frames
+     */
+    void copy(std::vector<FrameStats>* stats);
+
+    /**
+     *  \brief Get a percentile of the frame times kept
+     *
+     *  \param percentile From 0 to 100 eg. 99 for the 99th percentile
+     *
+     *  \return float of milliseconds, 0 without frames
+     */
+    float getFrameTimePercentile(float percentile);
+
+    /**
+     *  \brief Get a percentile of the update times kept
+     *
+     *  \param percentile From 0 to 100 eg. 50 for the median
+     *
+     *  \return float of milliseconds, 0 without frames
+     */
+    float getUpdateTimePercentile(float percentile);
+
+    /**
+     *  \brief Get a percentile of the render times kept
+     *
+     *  \param percentile From 0 to 100 eg. 95
+     *
+     *  \return float of milliseconds, 0 without frames
+     */
+    float getRenderTimePercentile(float percentile);
+  };
+}}
+
+#endif
@@ -35,13 +35,19 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <iostream>
+#include "sprite_record.h"
 
 
 namespace blackhole {
 namespace graphics {
 
+  class RenderCommandBuffer;
+
   /**
-   *  \brief The abstract class for all rendered images
+   *  \brief The abstract class for all rendered images. Window records
+   *         them into a RenderCommandBuffer each frame and never calls
+   *         draw(), so a subclass that only overrides draw() is not
+   *         drawn by Window. Override recordDraw() instead
    */
   
   class ImageBase {
@@ -52,8 +58,39 @@ namespace graphics {
   
     SDL_Rect destRect;
     SDL_Texture* texture;
+    SpriteRecord record;
     void init(const char* file, SDL_Renderer* renderer);
+
+    /**
+     *  \brief Choose how Window draws the ImageBase. Classes built
+     *         straight on ImageBase are recorded through getTexture(),
+     *         getSrcRect(), getDestRect(), getRendererFlip() and
+     *         recordDraw(). Image, Sprite, SpriteSheet, Animation,
+     *         AnimatorController and Text turn this off and are drawn
+     *         from their record, so a class built on one of them that
+     *         overrides those functions calls this with true in its
+     *         constructor
+     *
+     *  \param custom true to draw through the virtual functions
+     */
+    void setCustomDraw(bool custom);
   public:
+    ImageBase();
+    ImageBase(const ImageBase& image);
+    ImageBase& operator=(const ImageBase& image);
+    virtual ~ImageBase();
+
+    /**
+     *  \brief Get the draw data of the ImageBase. Classes that keep it up to
+     *         date are drawn without virtual calls, others are recorded
+     *         through recordDraw()
+     *
+     *  \return SpriteRecord* of the ImageBase
+     */
+    SpriteRecord* getRecord() {
+      return &record;
+    }
+
 
     /**
      *  \brief Overridable function for getting x position
@@ -75,7 +112,9 @@ namespace graphics {
 
 
     /**
-     *  \brief Overridable function for updating ImageBase time
+     *  \brief Overridable function for updating ImageBase time. Window no
+     *         longer calls it every frame; Animation reads the clock of its
+     *         AnimationSystem instead
      *
      *  \param time The amount of time passed in the frame
      */
@@ -180,6 +219,52 @@ namespace graphics {
     virtual SDL_Rect* getSrcRect();
 
 
+    /**
+     *  \brief Overridable function for drawing the ImageBase straight
+     *         away. The default copies getTexture() from getSrcRect() to
+     *         getDestRect(). Window does not call it, as frames are drawn
+     *         on the render thread from what recordDraw() recorded.
+     *         Camera::getTexture() does
+     *
+     *  \param renderer The renderer of the Window
+     */
+    virtual void draw(SDL_Renderer* renderer);
+
+    /**
+     *  \brief Overridable function for recording the draws of an ImageBase
+     *         whose record has custom set. Called by Window on the thread
+     *         that runs the main loop while the frame is recorded, one
+     *         ImageBase at a time and never on the ThreadPool, so it may
+     *         read state shared with other images. The default records
+     *         getTexture() from getSrcRect() to getDestRect() with
+     *         getRendererFlip()
+     *
+     *  \param commands The buffer of the frame
+     *  \param layer The layer to draw on
+     */
+    virtual void recordDraw(RenderCommandBuffer* commands, int layer);
+
+    /**
+     *  \brief Attach the ImageBase to a TransformNode. Its position is then
+     *         relative to the node and it is rotated and scaled with it.
+     *         Classes that override draw() ignore the node
+     *
+     *  \param transform The TransformNode to follow. NULL to detach
+     *
+     *  \sa getTransform()
+     */
+    void setTransform(TransformNode* transform);
+
+    /**
+     *  \brief Get the TransformNode the ImageBase follows
+     *
+     *  \return TransformNode* of the node or NULL
+     *
+     *  \sa setTransform()
+     */
+    TransformNode* getTransform();
+
+
     /**
      *  \brief Set the layer to be rendered on. 0 - low layer. 100 - high layer
      *
@@ -34,6 +34,7 @@
 #define IMAGE_HOLDER_H
 
 #include "imageBase.h"
+#include "sprite_record.h"
 
 namespace blackhole {
 namespace graphics {
@@ -41,7 +42,8 @@ namespace graphics {
    *  \brief Holder for the ImageBase address to prevent pointer corruption
    */
   struct ImageHolder {
-    ImageBase* image;  /**< Pointer to the ImageBase */
+    ImageBase* image;      /**< Pointer to the ImageBase */
+    SpriteRecord* record;  /**< Pointer to the SpriteRecord of the image */
   };
 }}
 
@@ -0,0 +1,267 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file particle_emitter.h
+ *
+ * A blackhole library class for simulating and drawing many particles
+ */
+
+#pragma once
+#ifndef PARTICLE_EMITTER_H
+#define PARTICLE_EMITTER_H
+
+#include "imageBase.h"
+#include "spritesheet.h"
+#include <functional>
+#include <vector>
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief A class for sparks, smoke and debris built on ImageBase
+   *
+   *  Every particle is a few entries in flat arrays instead of an object,
+   *  so update() runs over them as loops the compiler vectorizes and can
+   *  split across the ThreadPool. All particles are drawn with one
+   *  SDL_RenderGeometry call. The particles play through the frames of
+   *  the SpriteSheet over their lifetime and fade from the start color to
+   *  the end color. Added with Window::addEmitter() they are updated by
+   *  the simulation every tick and each frame gets a copy of the
+   *  vertices to draw.
+   */
+  class ParticleEmitter : public ImageBase {
+  private:
+    float x;
+    float y;
+
+    SpriteSheet* sheet;
+    int textureWidth;
+    int textureHeight;
+    float width;
+    float height;
+
+    int capacity;
+    int count = 0;
+    int threads = 1;
+    Uint32 seed = 0x9E3779B9;
+
+    float rate = 0;
+    float emitted = 0;
+    float minLife = 1;
+    float maxLife = 1;
+    float minSpeed = 0;
+    float maxSpeed = 0;
+    float angle = 0;
+    float spread = 6.2831853f;
+    float accelerationX = 0;
+    float accelerationY = 0;
+    SDL_Color startColor = {0xFF, 0xFF, 0xFF, 0xFF};
+    SDL_Color endColor = {0xFF, 0xFF, 0xFF, 0x00};
+
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velX;
+    std::vector<float> velY;
+    std::vector<float> age;
+    std::vector<float> inverseLife;
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    float random();
+    void integrate(int begin, int end, float time);
+    void build(int begin, int end);
+    void parallel(const std::function<void(int, int)>& kernel);
+  public:
+    /**
+     *  \brief Constructor of the ParticleEmitter
+     *
+     *  \param sheet The SpriteSheet the particles take their frames from.
+     *               NULL for plain colored squares
+     *  \param capacity The most particles alive at once
+     *  \param x The x position particles are emitted from
+     *  \param y The y position particles are emitted from
+     */
+    ParticleEmitter(SpriteSheet* sheet, int capacity, float x = 0, float y = 0);
+    ~ParticleEmitter();
+
+    /**
+     *  \brief Emit particles straight away. Particles past the capacity
+     *         are dropped
+     *
+     *  \param amount The amount of particles to emit
+     *
+     *  \sa setRate()
+     */
+    void emit(int amount);
+
+    /**
+     *  \brief Move every particle and emit new ones. Called every tick by
+     *         the World the emitter was added to with addEmitter()
+     *
+     *  \param time The amount of time passed in the frame
+     */
+    void update(float time);
+
+
+
+    /**
+     *  \brief Set how many particles are emitted every second by update()
+     *
+     *  \param rate Particles per second eg. 500
+     */
+    void setRate(float rate);
+
+    /**
+     *  \brief Set how long particles live. Each particle picks a random
+     *         time between min and max
+     *
+     *  \param min The shortest lifetime in seconds
+     *  \param max The longest lifetime in seconds
+     */
+    void setLifetime(float min, float max);
+
+    /**
+     *  \brief Set the velocity particles are emitted with
+     *
+     *  \param min The slowest speed in pixels per second
+     *  \param max The fastest speed in pixels per second
+     *  \param angle The direction in radians. 0 is right
+     *  \param spread The width of the cone around angle in radians
+     */
+    void setVelocity(float min, float max, float angle = 0, float spread = 6.2831853f);
+
+    /**
+     *  \brief Set the acceleration of every particle eg. gravity
+     *
+     *  \param x The x acceleration in pixels per second squared
+     *  \param y The y acceleration in pixels per second squared
+     */
+    void setAcceleration(float x, float y);
+
+    /**
+     *  \brief Set the colors particles fade between over their lifetime
+     *
+     *  \param start The color when a particle is emitted
+     *  \param end The color when a particle dies
+     */
+    void setColor(SDL_Color start, SDL_Color end);
+
+    /**
+     *  \brief Set the size particles are drawn at
+     *
+     *  \param width The width in pixels
+     *  \param height The height in pixels
+     */
+    void setSize(float width, float height);
+
+    /**
+     *  \brief Set the amount of ThreadPool tasks update() splits
+     *         particles across. Chunks are never smaller than 4096
+     *         particles
+     *
+     *  \param threads The amount of tasks. 1 to update on the caller
+     */
+    void setThreads(int threads);
+
+    /**
+     *  \brief Get the amount of particles alive
+     *
+     *  \return int of the particle count
+     */
+    int getCount();
+
+
+
+    /**
+     *  \brief Set the x position particles are emitted from
+     *
+     *  \param x The x position
+     *
+     *  \sa getX()
+     */
+    void setX(float x);
+
+    /**
+     *  \brief Set the y position particles are emitted from
+     *
+     *  \param y The y position
+     *
+     *  \sa getY()
+     */
+    void setY(float y);
+
+    /**
+     *  \brief Get the x position particles are emitted from
+     *
+     *  \sa setX()
+     */
+    float getX();
+
+    /**
+     *  \brief Get the y position particles are emitted from
+     *
+     *  \sa setY()
+     */
+    float getY();
+
+
+
+    /**
+     *  \brief Get a pointer to the SpriteSheet texture
+     *
+     *  \return SDL_Texture* of the SpriteSheet. NULL for plain squares
+     */
+    SDL_Texture* getTexture();
+
+    /**
+     *  \brief Get a pointer to the rect around every particle, used for
+     *         culling
+     *
+     *  \return SDL_Rect* bounds of the particles
+     */
+    SDL_Rect* getDestRect();
+
+    /**
+     *  \brief Record every particle as one geometry draw. The vertices
+     *         are copied into the buffer
+     *
+     *  \param commands The buffer of the frame
+     *  \param layer The layer to draw on
+     */
+    void recordDraw(RenderCommandBuffer* commands, int layer);
+
+    /**
+     *  \brief Draw every particle with one SDL_RenderGeometry call straight
+     *         away. Only call on the thread that runs update()
+     *
+     *  \param renderer The renderer of the Window
+     */
+    void draw(SDL_Renderer* renderer);
+  };
+}}
+
+#endif
@@ -0,0 +1,155 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file render_cache.h
+ *
+ * A blackhole library class for keeping draws that rarely change in a texture
+ */
+
+#pragma once
+#ifndef RENDER_CACHE_H
+#define RENDER_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "sprite_record.h"
+#include "render_command_buffer.h"
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief A texture holding the draws of a set of SpriteRecord. Every
+   *         frame the records are handed over with add() between begin()
+   *         and end(), and only the regions where a record was added,
+   *         removed, moved or changed frame are drawn again. The draws
+   *         may instead be handed over already recorded with update()
+   */
+  class RenderCache {
+  private:
+    struct Entry {
+      SpriteRecord* record;
+      SDL_Texture* texture;
+      SDL_Rect src;
+      SDL_FRect dest;
+      SDL_RendererFlip flip;
+      bool hasSrc;
+      SDL_FPoint center;
+      float angle;
+      bool geometry;
+      int command;
+      Uint32 transformVersion;
+      SDL_Rect bounds;
+    };
+
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;
+    int width;
+    int height;
+
+    std::vector<Entry> entries;
+    std::vector<SDL_Rect> dirty;
+    int count;
+    bool full;
+    Uint32 version;
+    RenderCommandBuffer* commands;
+
+    void invalidate(const SDL_Rect* rect);
+    void snapshot(Entry* entry, SpriteRecord* record);
+    void snapshot(Entry* entry, RenderCommand* command, int index);
+    bool replace(Entry* entry, const Entry& current);
+    bool changed(Entry* entry);
+    void insert(const Entry& entry);
+    void redraw(const SDL_Rect* rect);
+  public:
+
+    /**
+     *  \brief The constructor of RenderCache
+     *
+     *  \param renderer The renderer of the Window
+     *  \param w The width of the cached area
+     *  \param h The height of the cached area
+     */
+    RenderCache(SDL_Renderer* renderer, int w, int h);
+    RenderCache(const RenderCache&) = delete;
+    RenderCache& operator=(const RenderCache&) = delete;
+    ~RenderCache();
+
+    /**
+     *  \brief Start handing over the records for this frame
+     *
+     *  \sa add()
+     *  \sa end()
+     */
+    void begin();
+
+    /**
+     *  \brief Hand over the next record, in draw order
+     *
+     *  \param record The SpriteRecord to cache
+     */
+    void add(SpriteRecord* record);
+
+    /**
+     *  \brief Finish the frame and draw the changed regions again
+     *
+     *  \return true if anything was drawn again
+     */
+    bool end();
+
+    /**
+     *  \brief Hand over a whole frame of recorded draws instead of
+     *         records and draw the changed regions again. The commands are
+     *         compared by what they draw, so images that are gone by the
+     *         time the cache is drawn are never read
+     *
+     *  \param commands The draws in order
+     *
+     *  \return true if anything was drawn again
+     */
+    bool update(RenderCommandBuffer* commands);
+
+    /**
+     *  \brief Draw everything again on the next end()
+     */
+    void invalidateAll();
+
+    /**
+     *  \brief Get a number that changes every time end() draws again
+     *
+     *  \return Uint32 of the version
+     */
+    Uint32 getVersion();
+
+    /**
+     *  \brief Get the texture holding the cached draws
+     *
+     *  \return SDL_Texture* of the cache
+     */
+    SDL_Texture* getTexture();
+  };
+}}
+
+#endif
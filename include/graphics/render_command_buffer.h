@@ -0,0 +1,224 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file render_command_buffer.h
+ *
+ * A blackhole library class for recording, sorting and submitting draws
+ */
+
+#pragma once
+#ifndef RENDER_COMMAND_BUFFER_H
+#define RENDER_COMMAND_BUFFER_H
+
+#include <SDL2/SDL.h>
+#include <unordered_map>
+#include <vector>
+#include "sprite_record.h"
+#include "frame_stats.h"
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief One recorded texture copy or geometry draw. It holds
+   *         everything needed to draw, so the render thread never reads
+   *         the image it came from
+   */
+  struct RenderCommand {
+    Uint64 key;              /**< The sort key, lowest is drawn first */
+    SDL_Texture* texture;    /**< The texture to copy from */
+    SDL_Rect src;            /**< The rect of the texture to copy */
+    SDL_FRect dest;          /**< The rect to copy to */
+    SDL_FPoint center;       /**< The point to rotate about, relative to dest */
+    float angle;             /**< The rotation in degrees clockwise */
+    SDL_RendererFlip flip;   /**< The flip to copy with */
+    bool hasSrc;             /**< false to copy the whole texture */
+    int firstVertex;         /**< The first vertex of a geometry draw in the buffer */
+    int numVertices;         /**< The amount of vertices of a geometry draw */
+    int firstIndex;          /**< The first index of a geometry draw in the buffer */
+    int numIndices;          /**< Not 0 to draw the vertices with SDL_RenderGeometry instead */
+  };
+
+  /**
+   *  \brief A list of draws recorded during a frame. The commands are kept
+   *         in one array that is reused every frame, sorted by a 64 bit
+   *         key with a radix sort and then submitted in one go. The key
+   *         holds the layer, then optionally the texture so draws sharing a
+   *         texture are next to each other, then the order of recording.
+   *         A buffer can be saved and loaded to replay a frame
+   */
+  class RenderCommandBuffer {
+  private:
+    struct SortEntry {
+      Uint64 key;
+      Uint32 command;
+    };
+
+    std::vector<RenderCommand> commands;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    std::vector<SortEntry> order;
+    std::vector<SortEntry> scratch;
+    std::unordered_map<SDL_Texture*, Uint32> textureIds;
+    std::vector<SDL_Texture*> ownedTextures;
+    bool sortByTexture;
+    bool sorted;
+
+    Uint64 makeKey(int layer, SDL_Texture* texture);
+    void releaseTextures();
+    void draw(SDL_Renderer* renderer, RenderCommand& command);
+  public:
+    RenderCommandBuffer();
+    RenderCommandBuffer(const RenderCommandBuffer&) = delete;
+    RenderCommandBuffer& operator=(const RenderCommandBuffer&) = delete;
+    ~RenderCommandBuffer();
+
+    /**
+     *  \brief Remove every command, keeping the memory for the next frame
+     */
+    void clear();
+
+    /**
+     *  \brief Group draws by texture inside each layer. Faster, but
+     *         overlapping images on one layer may swap
+     *
+     *  \param sortByTexture true to group by texture
+     */
+    void setSortByTexture(bool sortByTexture);
+
+    /**
+     *  \brief Record the draw of a SpriteRecord. Records with custom set
+     *         are recorded by ImageBase::recordDraw()
+     *
+     *  \param record The SpriteRecord to draw
+     *  \param layer The layer to draw on
+     */
+    void add(SpriteRecord* record, int layer);
+
+    /**
+     *  \brief Record a texture copy
+     *
+     *  \param texture The texture to copy
+     *  \param src The rect of the texture to copy. NULL for all of it
+     *  \param dest The rect to copy to
+     *  \param layer The layer to draw on
+     *  \param flip The flip to copy with
+     */
+    void addTexture(SDL_Texture* texture, const SDL_Rect* src, const SDL_FRect* dest, int layer, SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+    /**
+     *  \brief Record a SDL_RenderGeometry draw. The vertices and indices
+     *         are copied so the caller may change them straight away
+     *
+     *  \param texture The texture to draw with. NULL for plain colors
+     *  \param vertices The vertices to draw
+     *  \param numVertices The amount of vertices
+     *  \param indices The triangles as indices into vertices
+     *  \param numIndices The amount of indices
+     *  \param layer The layer to draw on
+     */
+    void addGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int numVertices, const int* indices, int numIndices, int layer);
+
+    /**
+     *  \brief Change the texture of a recorded command, eg. one recorded
+     *         before the texture it copies is drawn
+     *
+     *  \param index The position the command was recorded at, the
+     *         getCount() before recording it
+     *  \param texture The texture to draw with
+     */
+    void setTexture(int index, SDL_Texture* texture);
+
+    /**
+     *  \brief Move the commands of another buffer to the end of this one
+     *         in the order they were recorded, keeping their layers. Lets
+     *         threads record into their own buffers
+     *
+     *  \param other The buffer to take the commands from. Left empty
+     */
+    void append(RenderCommandBuffer* other);
+
+    /**
+     *  \brief Sort the commands by key. Called by submit() if needed
+     */
+    void sort();
+
+    /**
+     *  \brief Draw every command in key order
+     *
+     *  \param renderer The renderer to draw to
+     *  \param stats Not NULL to add the draw calls and texture binds to
+     */
+    void submit(SDL_Renderer* renderer, FrameStats* stats = NULL);
+
+    /**
+     *  \brief Draw one command straight away, eg. to draw a region again
+     *
+     *  \param renderer The renderer to draw to
+     *  \param index The position in the sorted order
+     */
+    void drawCommand(SDL_Renderer* renderer, int index);
+
+    /**
+     *  \brief Get the number of commands
+     *
+     *  \return int of the number of commands
+     */
+    int getCount();
+
+    /**
+     *  \brief Get a command in key order after sort()
+     *
+     *  \param index The position in the sorted order
+     *
+     *  \return RenderCommand* of the command
+     */
+    RenderCommand* getCommand(int index);
+
+    /**
+     *  \brief Save the commands to a file. Textures are saved by size only
+     *         and geometry is left out
+     *
+     *  \param file The path to write to
+     *
+     *  \return true on success
+     */
+    bool save(const char* file);
+
+    /**
+     *  \brief Replace the commands with ones from save(). Each texture is
+     *         replaced by a blank target of the same size owned by the
+     *         buffer, which is enough to replay the frame for profiling
+     *
+     *  \param file The path to read from
+     *  \param renderer The renderer to create the textures with
+     *
+     *  \return true on success
+     */
+    bool load(const char* file, SDL_Renderer* renderer);
+  };
+}}
+
+#endif
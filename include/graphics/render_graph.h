@@ -0,0 +1,175 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file render_graph.h
+ *
+ * A blackhole library class for scheduling render passes
+ */
+
+#pragma once
+#ifndef RENDER_GRAPH_H
+#define RENDER_GRAPH_H
+
+#include <SDL2/SDL.h>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+#include "render_target_pool.h"
+
+namespace blackhole {
+namespace graphics {
+
+  class RenderGraph;
+
+  /**
+   *  \brief A texture read or written by the passes of a RenderGraph
+   */
+  typedef int RenderResource;
+
+  /**
+   *  \brief The RenderResource of the window itself
+   */
+  const RenderResource BACKBUFFER = 0;
+
+  /**
+   *  \brief The function run for a pass. The render target is already
+   *         set to the output of the pass
+   */
+  typedef std::function<void(SDL_Renderer* renderer, RenderGraph* graph)> RenderPassFunction;
+
+  /**
+   *  \brief A list of render passes declaring what they read and write.
+   *         Passes run in the order they are added. On execute() passes
+   *         whose output nothing uses are dropped, and transient targets
+   *         are taken from a RenderTargetPool only for the passes between
+   *         their first and last use, so targets that are never alive at
+   *         the same time share one texture
+   */
+  class RenderGraph {
+  private:
+    struct Resource {
+      SDL_Texture* texture;
+      int w;
+      int h;
+      Uint32 format;
+      bool transient;
+      bool needed;
+      int first;
+      int last;
+    };
+
+    struct Pass {
+      const char* name;
+      int firstInput;
+      int numInputs;
+      RenderResource output;
+      RenderPassFunction execute;
+      bool alive;
+    };
+
+    SDL_Renderer* renderer;
+    RenderTargetPool* pool;
+    std::vector<Resource> resources;
+    std::vector<RenderResource> inputs;
+    std::vector<Pass> passes;
+    int executed;
+    int targetSwitches;
+
+    void touch(RenderResource resource, int pass);
+  public:
+
+    /**
+     *  \brief The constructor of RenderGraph
+     *
+     *  \param renderer The renderer of the Window
+     *  \param pool The pool to take transient targets from
+     */
+    RenderGraph(SDL_Renderer* renderer, RenderTargetPool* pool);
+
+    /**
+     *  \brief Declare a target that only lives for this frame
+     *
+     *  \param w The width of the target
+     *  \param h The height of the target
+     *  \param format The SDL_PixelFormatEnum of the target
+     *
+     *  \return RenderResource of the target
+     */
+    RenderResource createTarget(int w, int h, Uint32 format = SDL_PIXELFORMAT_RGBA8888);
+
+    /**
+     *  \brief Use a texture owned elsewhere. Passes writing to it are
+     *         never dropped
+     *
+     *  \param texture The render target texture
+     *
+     *  \return RenderResource of the texture
+     */
+    RenderResource importTexture(SDL_Texture* texture);
+
+    /**
+     *  \brief Add a pass
+     *
+     *  \param name The name of the pass eg. lighting
+     *  \param inputs The resources the pass reads
+     *  \param output The resource the pass draws to
+     *  \param execute The function drawing the pass
+     */
+    void addPass(const char* name, std::initializer_list<RenderResource> inputs, RenderResource output, RenderPassFunction execute);
+
+    /**
+     *  \brief Drop unused passes, run the others and clear the graph for
+     *         the next frame
+     */
+    void execute();
+
+    /**
+     *  \brief Get the texture of a resource. Only valid while a pass
+     *         reading or writing it runs
+     *
+     *  \param resource The resource
+     *
+     *  \return SDL_Texture* of the resource. NULL for BACKBUFFER
+     */
+    SDL_Texture* getTexture(RenderResource resource);
+
+    /**
+     *  \brief Get the number of passes run by the last execute()
+     *
+     *  \return int of the number of passes
+     */
+    int getExecutedPasses();
+
+    /**
+     *  \brief Get the number of times the last execute() changed the
+     *         render target
+     *
+     *  \return int of the number of target switches
+     */
+    int getTargetSwitches();
+  };
+}}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file render_target_pool.h
+ *
+ * A blackhole library class for sharing render target textures
+ */
+
+#pragma once
+#ifndef RENDER_TARGET_POOL_H
+#define RENDER_TARGET_POOL_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief A pool of render target textures keyed by size and format.
+   *         Targets are handed out with acquire() and given back with
+   *         release(), so passes that are not alive at the same time
+   *         share one texture
+   */
+  class RenderTargetPool {
+  private:
+    struct Target {
+      SDL_Texture* texture;
+      int w;
+      int h;
+      Uint32 format;
+      bool used;
+      int unusedFrames;
+    };
+
+    SDL_Renderer* renderer;
+    std::vector<Target> targets;
+    int maxUnusedFrames;
+  public:
+
+    /**
+     *  \brief The constructor of RenderTargetPool
+     *
+     *  \param renderer The renderer to create the targets with
+     *  \param maxUnusedFrames Targets unused for longer than this are destroyed
+     */
+    RenderTargetPool(SDL_Renderer* renderer, int maxUnusedFrames = 60);
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+    ~RenderTargetPool();
+
+    /**
+     *  \brief Get a free target, creating one if none matches. The
+     *         contents are left over from the last user
+     *
+     *  \param w The width of the target
+     *  \param h The height of the target
+     *  \param format The SDL_PixelFormatEnum of the target
+     *
+     *  \return SDL_Texture* of the target or NULL on failure
+     *
+     *  \sa release()
+     */
+    SDL_Texture* acquire(int w, int h, Uint32 format);
+
+    /**
+     *  \brief Give a target back to the pool
+     *
+     *  \param texture The target from acquire()
+     */
+    void release(SDL_Texture* texture);
+
+    /**
+     *  \brief Count a frame and destroy the targets that have not been
+     *         used for too long
+     */
+    void endFrame();
+
+    /**
+     *  \brief Get the number of targets the pool owns
+     *
+     *  \return int of the number of targets
+     */
+    int getCount();
+  };
+}}
+
+#endif
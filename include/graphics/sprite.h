@@ -0,0 +1,165 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file sprite.h
+ *
+ * A blackhole library class for drawing one frame of a shared SpriteSheet
+ */
+
+#pragma once
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include "imageBase.h"
+#include "spritesheet.h"
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief A class for one instance of a SpriteSheet built on ImageBase.
+   *         The SpriteSheet is only read so any number of Sprite can share
+   *         its texture, while the frame, position and flip belong to the
+   *         Sprite
+   */
+  class Sprite : public ImageBase {
+  private:
+    SpriteSheet* sheet;
+
+    float x;
+    float y;
+
+    int frame;
+    SDL_Rect srcRect;
+    SDL_Point offset;
+
+    void updateRecord();
+  public:
+    /**
+     *  \brief Constructor of the Sprite
+     *
+     *  \param sheet The SpriteSheet to take frames from
+     *  \param x The x position of the Sprite
+     *  \param y the y position of the Sprite
+     *  \param frame The frame to show
+     */
+    Sprite(SpriteSheet* sheet, float x = 0, float y = 0, int frame = 0);
+    ~Sprite();
+
+    /**
+     *  \brief Set the frame that the Sprite is showing
+     *
+     *  \param frame The frame to show
+     *
+     *  \sa getFrame()
+     */
+    void setFrame(int frame);
+
+    /**
+     *  \brief Get the frame that the Sprite is showing
+     *
+     *  \return number of frame shown eg. 0
+     *
+     *  \sa setFrame()
+     */
+    int getFrame();
+
+    /**
+     *  \brief Get the SpriteSheet the Sprite takes its frames from
+     *
+     *  \return SpriteSheet* of the Sprite
+     */
+    SpriteSheet* getSpriteSheet();
+
+
+
+    /**
+     *  \brief Set the x position of the Sprite
+     *
+     *  \param x The x position you want the sprite to render on
+     *
+     *  \sa getX()
+     *  \sa getY()
+     *  \sa setY()
+     */
+    void setX(float x);
+
+    /**
+     *  \brief Set the y position of the Sprite
+     *
+     *  \param y The y position you want the sprite to render on
+     *
+     *  \sa getY()
+     *  \sa getX()
+     *  \sa setX()
+     */
+    void setY(float y);
+
+    /**
+     *  \brief Get the x position of the Sprite
+     *
+     *  \sa setX()
+     *  \sa setY()
+     *  \sa getY()
+     */
+    float getX();
+
+    /**
+     *  \brief Get the y position of the Sprite
+     *
+     *  \sa setY()
+     *  \sa setX()
+     *  \sa getX()
+     */
+    float getY();
+
+
+
+    /**
+     *  \brief Get a pointer to the SpriteSheet texture
+     *
+     *  \return SDL_Texture* of the SpriteSheet for rendering
+     */
+    SDL_Texture* getTexture();
+
+    /**
+     *  \brief Get a pointer to the destination rect used for positioning
+     *         with the renderer
+     *
+     *  \return SDL_Rect* destRect of Sprite
+     */
+    SDL_Rect* getDestRect();
+
+    /**
+     *  \brief Get a pointer to the source rect used for getting the frame
+     *         of the SpriteSheet
+     *
+     *  \return SDL_Rect* frame rect of Sprite
+     */
+    SDL_Rect* getSrcRect();
+  };
+}}
+
+#endif
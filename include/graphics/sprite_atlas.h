@@ -0,0 +1,142 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file sprite_atlas.h
+ *
+ * A blackhole library class for loading Aseprite and TexturePacker atlases
+ */
+
+#pragma once
+#ifndef SPRITE_ATLAS_H
+#define SPRITE_ATLAS_H
+
+#include "animation.h"
+#include "animation_id.h"
+#include "spritesheet.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief A named range of atlas frames eg. an Aseprite tag
+   */
+  struct AnimationTag {
+    AnimationId id;           /**< The hashed name of the tag */
+    std::string name;         /**< The name of the tag eg. running */
+    std::vector<int> frames;  /**< The frames in playing order */
+  };
+
+  /**
+   *  \brief A class for loading a packed SpriteSheet from the JSON data
+   *         exported by Aseprite or TexturePacker. Frames keep their trim
+   *         offset and duration and tags become Animation frame orders.
+   *         Rotated frames are skipped, so export without rotation
+   */
+  class SpriteAtlas {
+  private:
+    SpriteSheet* sheet;
+    std::vector<std::string> frameNames;
+    std::vector<AnimationTag> tags;
+    std::unordered_map<AnimationId, int> tagIndex;
+  public:
+    /**
+     *  \brief Constructor of the SpriteAtlas
+     *
+     *  \param file The location of the JSON file. The image is loaded
+     *         from the path in its meta data
+     *  \param renderer The renderer of the Window
+     */
+    SpriteAtlas(const char* file, SDL_Renderer* renderer);
+    SpriteAtlas(const SpriteAtlas&) = delete;
+    SpriteAtlas& operator=(const SpriteAtlas&) = delete;
+    ~SpriteAtlas();
+
+    /**
+     *  \brief Get the SpriteSheet holding every frame of the atlas
+     *
+     *  \return SpriteSheet* of the atlas. NULL if it failed to load
+     */
+    SpriteSheet* getSpriteSheet();
+
+    /**
+     *  \brief Get a frame by the name it was exported with
+     *
+     *  \param name The name of the frame eg. run 0.aseprite
+     *
+     *  \return int of the frame. -1 if it was not found
+     */
+    int getFrame(const char* name);
+
+    /**
+     *  \brief Get a tag by name
+     *
+     *  \param tag The AnimationId of the tag eg. animationId("running")
+     *
+     *  \return const AnimationTag* of the tag. NULL if it was not found
+     *
+     *  \sa getNumTags()
+     */
+    const AnimationTag* getTag(AnimationId tag);
+
+    /**
+     *  \brief Get the amount of tags in the atlas
+     *
+     *  \return int of the tag count
+     *
+     *  \sa getTagAt()
+     */
+    int getNumTags();
+
+    /**
+     *  \brief Get a tag by the order it was exported in
+     *
+     *  \param index The tag to get. Less than getNumTags()
+     *
+     *  \return const AnimationTag* of the tag. NULL if index is out of
+     *          range
+     */
+    const AnimationTag* getTagAt(int index);
+
+    /**
+     *  \brief Create an Animation that plays a tag with the duration
+     *         of each frame
+     *
+     *  \param tag The AnimationId of the tag eg. animationId("running")
+     *  \param speed The amount of time between frames. 0 to use the
+     *         exported durations, or 0.1 seconds if the atlas has none
+     *  \param system The AnimationSystem that advances the Animation.
+     *                NULL for the default system
+     *
+     *  \return Animation* of the tag, deleted by the caller. NULL with an
+     *          error printed if the tag was not found
+     */
+    Animation* createAnimation(AnimationId tag, float speed = 0, AnimationSystem* system = NULL);
+  };
+}}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file sprite_record.h
+ *
+ * A blackhole library struct holding everything needed to draw an ImageBase
+ */
+
+#pragma once
+#ifndef SPRITE_RECORD_H
+#define SPRITE_RECORD_H
+
+#include <SDL2/SDL.h>
+
+namespace blackhole {
+namespace graphics {
+
+  class AnimationSystem;
+  class ImageBase;
+  class TransformNode;
+
+  /**
+   *  \brief The draw data of an ImageBase. The classes built on ImageBase
+   *         write it when they change so Window can draw without calling
+   *         any virtual functions
+   */
+  struct SpriteRecord {
+    SDL_Texture* texture;        /**< The texture to copy from */
+    SDL_Rect src;                /**< The rect of the texture to copy */
+    SDL_FRect dest;              /**< The rect to copy to, kept in floats for sub-pixel positions */
+    SDL_RendererFlip flip;       /**< The flip to copy with */
+    bool hasSrc;                 /**< false to copy the whole texture */
+    SDL_FPoint origin;           /**< The position of an animated record before the frame offset */
+    AnimationSystem* animation;  /**< The AnimationSystem the frame is read from. NULL if not animated */
+    int animationSlot;           /**< The slot in the AnimationSystem */
+    TransformNode* transform;    /**< The node dest is relative to. NULL if not attached */
+    SDL_Rect bounds;             /**< The whole pixels covered, written by getRecordDestRect() */
+    ImageBase* custom;           /**< Not NULL if the ImageBase is drawn through its virtual functions, see ImageBase::setCustomDraw() */
+  };
+
+  /**
+   *  \brief Get the whole pixels a SpriteRecord covers, used for culling
+   *
+   *  \param record The SpriteRecord to check
+   *
+   *  \return SDL_Rect* of the area drawn to
+   */
+  SDL_Rect* getRecordDestRect(SpriteRecord* record);
+
+  /**
+   *  \brief Work out where a SpriteRecord is drawn, evaluating its
+   *         animation and TransformNode. Not for records with custom set
+   *
+   *  \param record The SpriteRecord
+   *  \param dest Set to the rect to copy to
+   *  \param center Set to the point to rotate about, relative to dest
+   *  \param angle Set to the rotation in degrees clockwise
+   */
+  void resolveRecord(SpriteRecord* record, SDL_FRect* dest, SDL_FPoint* center, float* angle);
+
+  /**
+   *  \brief Draw a SpriteRecord, working out the frame first if it is
+   *         animated
+   *
+   *  \param renderer The renderer of the Window
+   *  \param record The SpriteRecord to draw
+   */
+  void drawRecord(SDL_Renderer* renderer, SpriteRecord* record);
+}}
+
+#endif
@@ -33,12 +33,52 @@
 #define SPRITE_SHEET_H
 
 #include "imageBase.h"
+#include <array>
+#include <vector>
 
 namespace blackhole {
 namespace graphics {
 
   /**
-   *  \brief A class for turning an image into frames built on ImageBase
+   *  \brief A struct for one frame of a packed SpriteSheet
+   */
+  struct SpriteFrame {
+    SDL_Rect rect;     /**< The frame in the SpriteSheet image */
+    SDL_Point offset;  /**< Where the trimmed frame is drawn from the sprite position */
+    float duration;    /**< Seconds the frame is shown. 0 to use the Animation speed */
+  };
+
+  /**
+   *  \brief A uniform SpriteSheet grid whose frame table is built at
+   *         compile time
+   *
+   *  \tparam Cols The amount of columns in the SpriteSheet image
+   *  \tparam Rows The amount of rows in the SpriteSheet image
+   *  \tparam W The width of one frame
+   *  \tparam H The height of one frame
+   */
+  template<int Cols, int Rows, int W, int H>
+  struct SpriteSheetLayout {
+    static constexpr int frames = Cols*Rows;  /**< The amount of frames */
+
+    /**
+     *  \brief Build the frame rects row by row
+     */
+    static constexpr std::array<SDL_Rect, Cols*Rows> build() {
+      std::array<SDL_Rect, Cols*Rows> rects{};
+      for(int i = 0; i < Cols*Rows; i++) {
+        rects[i] = { i%Cols*W, i/Cols*H, W, H };
+      }
+      return rects;
+    }
+
+    static constexpr std::array<SDL_Rect, Cols*Rows> rects = build();  /**< The frame table */
+  };
+
+  /**
+   *  \brief A class for turning an image into frames built on ImageBase.
+   *         Sprite and Animation only read the frames so one SpriteSheet
+   *         can be shared by any number of them
    */
   class SpriteSheet : public ImageBase {
   private:
@@ -54,6 +94,13 @@ namespace graphics {
     int frame;
   
     SDL_Rect srcRect;
+    std::vector<SDL_Rect> frameRects;
+    std::vector<SDL_Point> frameOffsets;
+    std::vector<float> frameDurations;
+
+    int wrapFrame(int frame);
+    SDL_Rect getWholeImage(const char* file);
+    void updateRecord();
   
   public:
     /**
@@ -67,6 +114,32 @@ namespace graphics {
      *  \param rows The amount of rows in the SpriteSheet image
      */
     SpriteSheet(const char* file, SDL_Renderer* renderer, float x = 0, float y = 0, int cols = 1, int rows = 1);
+
+    /**
+     *  \brief Constructor of the SpriteSheet with frames of any size
+     *
+     *  \param file The location of image file
+     *  \param renderer The renderer of the Window
+     *  \param frames The rect of every frame in the SpriteSheet image.
+     *         If empty an error is printed and the whole image is one
+     *         frame
+     *  \param x The x position of the Image
+     *  \param y the y position of the Image
+     */
+    SpriteSheet(const char* file, SDL_Renderer* renderer, const std::vector<SDL_Rect>& frames, float x = 0, float y = 0);
+
+    /**
+     *  \brief Constructor of the SpriteSheet with trimmed frames that each
+     *         have their own offset and duration
+     *
+     *  \param file The location of image file
+     *  \param renderer The renderer of the Window
+     *  \param frames Every frame in the SpriteSheet image. If empty an
+     *         error is printed and the whole image is one frame
+     *  \param x The x position of the Image
+     *  \param y the y position of the Image
+     */
+    SpriteSheet(const char* file, SDL_Renderer* renderer, const std::vector<SpriteFrame>& frames, float x = 0, float y = 0);
     ~SpriteSheet();
 
     /**
@@ -87,6 +160,55 @@ namespace graphics {
      */
     int getFrame();
 
+    /**
+     *  \brief Get the source rect of any frame without changing the frame
+     *          that the SpriteSheet is showing
+     *
+     *  \param frame The frame to get
+     *
+     *  \return SDL_Rect of the frame in the SpriteSheet image
+     *
+     *  \sa setFrame()
+     */
+    SDL_Rect getFrameRect(int frame);
+
+    /**
+     *  \brief Get where a trimmed frame is drawn from the sprite position
+     *
+     *  \param frame The frame to get
+     *
+     *  \return SDL_Point of the offset. {0, 0} for untrimmed frames
+     */
+    SDL_Point getFrameOffset(int frame);
+
+    /**
+     *  \brief Get how long a frame is shown
+     *
+     *  \param frame The frame to get
+     *
+     *  \return float of seconds. 0 if the frame uses the Animation speed
+     */
+    float getFrameDuration(int frame);
+
+    /**
+     *  \brief Get the amount of frames in the SpriteSheet
+     *
+     *  \return int of the frame count eg. 5
+     *
+     *  \sa getFrameTable()
+     */
+    int getFrameCount();
+
+    /**
+     *  \brief Get the rects of every frame, built when the SpriteSheet
+     *         was loaded
+     *
+     *  \return const SDL_Rect* to getFrameCount() frame rects
+     *
+     *  \sa getFrameCount()
+     */
+    const SDL_Rect* getFrameTable();
+
 
 
     /**
@@ -145,7 +267,45 @@ namespace graphics {
      *  \return SDL_Rect* frame rect of SpriteSheet
      */
     SDL_Rect* getSrcRect();
-  };  
+  };
+
+  /**
+   *  \brief A SpriteSheet whose frame table is a SpriteSheetLayout so
+   *         getFrameRect() is a single indexed load
+   *
+   *  \tparam Cols The amount of columns in the SpriteSheet image
+   *  \tparam Rows The amount of rows in the SpriteSheet image
+   *  \tparam W The width of one frame
+   *  \tparam H The height of one frame
+   */
+  template<int Cols, int Rows, int W, int H>
+  class StaticSpriteSheet : public SpriteSheet {
+  public:
+    typedef SpriteSheetLayout<Cols, Rows, W, H> Layout;  /**< The frame table */
+
+    /**
+     *  \brief Constructor of the StaticSpriteSheet
+     *
+     *  \param file The location of image file
+     *  \param renderer The renderer of the Window
+     *  \param x The x position of the Image
+     *  \param y the y position of the Image
+     */
+    StaticSpriteSheet(const char* file, SDL_Renderer* renderer, float x = 0, float y = 0)
+      : SpriteSheet(file, renderer, std::vector<SDL_Rect>(Layout::rects.begin(), Layout::rects.end()), x, y) {
+    }
+
+    /**
+     *  \brief Get the source rect of a frame from the compile time table
+     *
+     *  \param frame The frame to get. Must be less than Cols*Rows
+     *
+     *  \return SDL_Rect of the frame in the SpriteSheet image
+     */
+    static constexpr SDL_Rect getFrameRect(int frame) {
+      return Layout::rects[frame];
+    }
+  };
 }}
 
 #endif
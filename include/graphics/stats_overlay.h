@@ -0,0 +1,101 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file stats_overlay.h
+ *
+ * A blackhole library class for drawing frame statistics over a window
+ */
+
+#pragma once
+#ifndef STATS_OVERLAY_H
+#define STATS_OVERLAY_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "frame_stats.h"
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief Draws a graph of recent frame times and the counters of the
+   *         last frame from a FrameStatsRing. Text uses a built in pixel
+   *         font so no font has to be loaded, and everything is batched
+   *         into one filled rect call per color
+   */
+  class StatsOverlay {
+  private:
+    std::vector<FrameStats> frames;
+    std::vector<SDL_Rect> panel;
+    std::vector<SDL_Rect> bars;
+    std::vector<SDL_Rect> slowBars;
+    std::vector<SDL_Rect> text;
+    int x;
+    int y;
+    int scale;
+    float budget;
+
+    void addText(const char* string, int x, int y);
+  public:
+
+    /**
+     *  \brief The constructor of StatsOverlay
+     */
+    StatsOverlay();
+
+    /**
+     *  \brief Set where the top left of the overlay is drawn
+     *
+     *  \param x The x position in pixels
+     *  \param y The y position in pixels
+     */
+    void setPosition(int x, int y);
+
+    /**
+     *  \brief Set the size of the overlay
+     *
+     *  \param scale The pixels per pixel of the font and graph, eg. 2
+     */
+    void setScale(int scale);
+
+    /**
+     *  \brief Set the frame time drawn as the line across the graph.
+     *         Frames over it are drawn red
+     *
+     *  \param budget The time in milliseconds, eg. 1000/fps
+     */
+    void setBudget(float budget);
+
+    /**
+     *  \brief Draw the overlay to the current render target
+     *
+     *  \param renderer The renderer to draw with
+     *  \param stats The frames to draw
+     */
+    void draw(SDL_Renderer* renderer, FrameStatsRing* stats);
+  };
+}}
+
+#endif
@@ -0,0 +1,149 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file texture.h
+ *
+ * A blackhole library set of functions creating textures, with or without a renderer
+ */
+
+#pragma once
+#ifndef TEXTURE_H
+#define TEXTURE_H
+
+#include <SDL2/SDL.h>
+
+namespace blackhole {
+namespace graphics {
+
+  class FramePipeline;
+  class World;
+
+  /**
+   *  \brief Create a texture like SDL_CreateTexture(). Without a renderer,
+   *         eg. in a headless Window, the texture is a stub only keeping
+   *         its size and format, which SDL rejects if drawn
+   *
+   *  \param renderer The renderer, or NULL for a stub
+   *  \param format The SDL_PixelFormatEnum of the texture
+   *  \param access The SDL_TextureAccess of the texture
+   *  \param w The width of the texture
+   *  \param h The height of the texture
+   *
+   *  \return SDL_Texture* of the texture, NULL on failure
+   */
+  SDL_Texture* createTexture(SDL_Renderer* renderer, Uint32 format, int access, int w, int h);
+
+  /**
+   *  \brief Create a texture from a surface like
+   *         SDL_CreateTextureFromSurface(), or a stub of the same size
+   *         without a renderer
+   *
+   *  \param renderer The renderer, or NULL for a stub
+   *  \param surface The surface to copy
+   *
+   *  \return SDL_Texture* of the texture, NULL on failure
+   */
+  SDL_Texture* createTextureFromSurface(SDL_Renderer* renderer, SDL_Surface* surface);
+
+  /**
+   *  \brief Get the attributes of a texture or stub like SDL_QueryTexture()
+   *
+   *  \param texture The texture
+   *  \param format Set to the format. NULL to skip
+   *  \param access Set to the access. NULL to skip
+   *  \param w Set to the width. NULL to skip
+   *  \param h Set to the height. NULL to skip
+   *
+   *  \return int of 0 on success, negative on failure
+   */
+  int queryTexture(SDL_Texture* texture, Uint32* format, int* access, int* w, int* h);
+
+  /**
+   *  \brief Destroy a texture or stub
+   *
+   *  \param texture The texture
+   */
+  void destroyTexture(SDL_Texture* texture);
+
+  /**
+   *  \brief Destroy a texture once the frames in flight that may draw it
+   *         are drawn. Textures of a renderer with a FramePipeline go to
+   *         FramePipeline::releaseTexture(), others are destroyed straight
+   *         away. Use for textures the simulation thread stops using
+   *
+   *  \param texture The texture
+   */
+  void releaseTexture(SDL_Texture* texture);
+
+  /**
+   *  \brief Set the FramePipeline whose render thread destroys the
+   *         released textures of a renderer
+   *
+   *  \param renderer The renderer
+   *  \param pipeline The FramePipeline. NULL to destroy them straight away
+   */
+  void setTexturePipeline(SDL_Renderer* renderer, FramePipeline* pipeline);
+
+  /**
+   *  \brief Check if a texture is a stub made without a renderer
+   *
+   *  \param texture The texture
+   *
+   *  \return true if it is a stub
+   */
+  bool isTextureStub(SDL_Texture* texture);
+
+  /**
+   *  \brief Get an estimate of the memory used by the textures alive that
+   *         were made with createTexture() and createTextureFromSurface(),
+   *         from their size and format. Stubs count as the textures they
+   *         stand in for
+   *
+   *  \return Uint64 of the bytes
+   */
+  Uint64 getTextureMemory();
+
+  /**
+   *  \brief Get the estimated memory of the textures alive that were made
+   *         on a thread the World was current on, eg. by its Window
+   *
+   *  \param world The World
+   *
+   *  \return Uint64 of the bytes
+   *
+   *  \sa World::makeCurrent()
+   */
+  Uint64 getTextureMemory(World* world);
+
+  /**
+   *  \brief Stop counting textures for a World, leaving them only in the
+   *         total. Called by ~World
+   *
+   *  \param world The World
+   */
+  void forgetTextureWorld(World* world);
+}}
+
+#endif
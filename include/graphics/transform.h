@@ -0,0 +1,214 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file transform.h
+ *
+ * A blackhole library class for attaching images to each other
+ */
+
+#pragma once
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+namespace blackhole {
+namespace graphics {
+
+  /**
+   *  \brief The position, rotation and scale of a TransformNode after its
+   *         parents are applied
+   */
+  struct WorldTransform {
+    float a;         /**< Matrix column 1 x */
+    float b;         /**< Matrix column 1 y */
+    float c;         /**< Matrix column 2 x */
+    float d;         /**< Matrix column 2 y */
+    float x;         /**< x position */
+    float y;         /**< y position */
+    float rotation;  /**< Rotation in degrees clockwise */
+    float scaleX;    /**< Horizontal scale */
+    float scaleY;    /**< Vertical scale */
+  };
+
+  /**
+   *  \brief A node with a position, rotation and scale relative to its
+   *         parent. The world transform is cached and only worked out
+   *         again after the node or one of its parents changed, so nodes
+   *         that do not move cost nothing per frame
+   */
+  class TransformNode {
+  private:
+    float x;
+    float y;
+    float rotation;
+    float scaleX;
+    float scaleY;
+
+    TransformNode* parent;
+    std::vector<TransformNode*> children;
+
+    bool dirty;
+    Uint32 version;
+    WorldTransform world;
+
+    void markDirty();
+  public:
+
+    /**
+     *  \brief The constructor of TransformNode
+     *
+     *  \param x The x position relative to the parent
+     *  \param y The y position relative to the parent
+     *  \param rotation The rotation in degrees clockwise
+     *  \param scaleX The horizontal scale
+     *  \param scaleY The vertical scale
+     */
+    TransformNode(float x = 0, float y = 0, float rotation = 0, float scaleX = 1, float scaleY = 1);
+    TransformNode(const TransformNode&) = delete;
+    TransformNode& operator=(const TransformNode&) = delete;
+
+    /**
+     *  \brief Detaches the node from its parent and its children from it
+     */
+    ~TransformNode();
+
+    /**
+     *  \brief Set the x position relative to the parent
+     *
+     *  \param x The x position
+     */
+    void setX(float x);
+
+    /**
+     *  \brief Set the y position relative to the parent
+     *
+     *  \param y The y position
+     */
+    void setY(float y);
+
+    /**
+     *  \brief Set the position relative to the parent
+     *
+     *  \param x The x position
+     *  \param y The y position
+     */
+    void setPosition(float x, float y);
+
+    /**
+     *  \brief Set the rotation relative to the parent
+     *
+     *  \param rotation The rotation in degrees clockwise
+     */
+    void setRotation(float rotation);
+
+    /**
+     *  \brief Set the scale relative to the parent. Use the flip of the
+     *         image for mirroring, not negative scales
+     *
+     *  \param scaleX The horizontal scale
+     *  \param scaleY The vertical scale
+     */
+    void setScale(float scaleX, float scaleY);
+
+    /**
+     *  \brief Get the x position relative to the parent
+     *
+     *  \return float of the x position
+     */
+    float getX();
+
+    /**
+     *  \brief Get the y position relative to the parent
+     *
+     *  \return float of the y position
+     */
+    float getY();
+
+    /**
+     *  \brief Get the rotation relative to the parent
+     *
+     *  \return float of the rotation in degrees
+     */
+    float getRotation();
+
+    /**
+     *  \brief Get the horizontal scale relative to the parent
+     *
+     *  \return float of the horizontal scale
+     */
+    float getScaleX();
+
+    /**
+     *  \brief Get the vertical scale relative to the parent
+     *
+     *  \return float of the vertical scale
+     */
+    float getScaleY();
+
+    /**
+     *  \brief Attach the node to a parent so it moves with it
+     *
+     *  \param parent The new parent. NULL to detach
+     */
+    void setParent(TransformNode* parent);
+
+    /**
+     *  \brief Get the parent of the node
+     *
+     *  \return TransformNode* of the parent or NULL
+     */
+    TransformNode* getParent();
+
+    /**
+     *  \brief Get the world transform, working it out if the node or a
+     *         parent changed since the last call
+     *
+     *  \return const WorldTransform* of the node
+     */
+    const WorldTransform* getWorld();
+
+    /**
+     *  \brief Move a point from the space of the node into the world
+     *
+     *  \param x The x position relative to the node
+     *  \param y The y position relative to the node
+     *
+     *  \return SDL_FPoint of the point in the world
+     */
+    SDL_FPoint apply(float x, float y);
+
+    /**
+     *  \brief Get a number that changes every time the world transform
+     *         is worked out again
+     *
+     *  \return Uint32 of the version
+     */
+    Uint32 getVersion();
+  };
+}}
+
+#endif
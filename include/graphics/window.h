@@ -38,17 +38,37 @@
 #include <string>
 #include <list>
 #include <map>
+#include <set>
 #include <stdio.h>
 #include <sys/time.h>
 #include <thread>
 #include <ctime>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include "color.h"
 #include "imageHolder.h"
 #include "cameraHolder.h"
+#include "render_graph.h"
+#include "render_command_buffer.h"
+#include "frame_pipeline.h"
+#include "frame_stats.h"
+#include "stats_overlay.h"
+#include "context.h"
+#include "world.h"
+#include "../jobs/job_graph.h"
+#include "../input/input.h"
+#include "../input/event_dispatcher.h"
+#include "../input/input_log.h"
 
 namespace blackhole {
+namespace ecs {
+  class Registry;
+}
+
 namespace graphics {
+  class RenderCache;
 
   /**
    *  \brief A struct for 2d positions
@@ -65,10 +85,42 @@ namespace graphics {
   class Window {
   private:
     bool init();
+    void recordFrame(Frame* frame);
+    struct DrawChunk;
+    void recordDrawItems(Frame* frame, const DrawChunk& chunk, RenderCommandBuffer* buffer);
+    void recordCollator(Frame* frame, Camera* camera, int layer);
+    void renderWorld(Frame* frame);
+    void updateCollators(Frame* frame);
+    void updateStaticLayers(Frame* frame);
   private:
     SDL_Window* window;
     SDL_Renderer* renderer;
-    SDL_Texture* preRenderer;
+    RenderTargetPool* targetPool = NULL;
+    RenderGraph* graph = NULL;
+    FramePipeline pipeline;
+    std::atomic<bool> sortByTexture{false};
+
+    struct DrawItem {
+      SpriteRecord* record;
+      int layer;
+    };
+    struct DrawChunk {
+      int begin;
+      int end;
+      bool custom;
+      Camera* collator;
+    };
+    std::vector<DrawItem> drawItems;
+    std::vector<DrawChunk> drawChunks;
+    std::vector<std::unique_ptr<RenderCommandBuffer>> chunkCommands;
+    std::mutex captureMutex;
+    std::string captureFile;
+    std::atomic<bool> capturePending{false};
+    FrameStatsRing frameStats;
+    StatsOverlay statsOverlay;
+    std::atomic<bool> showStats{false};
+    Uint64 lastPresent = 0;
+    RenderResource (*renderPasses)(RenderGraph* graph, RenderResource world) = NULL;
 
     SDL_Rect renderFrame;
   
@@ -80,19 +132,36 @@ namespace graphics {
     floatXY scale;
     int fps;
 
-    float frameTime;
+    float frameTime = 0;
   
-    std::list<CameraHolder> cameraQueue;
-    std::list<ImageHolder> renderQueue;
-    const Uint8* keyboard_state = SDL_GetKeyboardState(NULL);
+    Context* context = NULL;
+    World world;
+    std::set<int> staticLayerIds;
+    std::map<int, RenderCache*> staticLayers;
+    SDL_Point staticLayerSize = {0, 0};
+    struct CollatorCache {
+      RenderCache* cache = NULL;
+      SDL_Point size = {0, 0};
+    };
+    std::map<Uint32, CollatorCache> collators;
+    input::Input input;
+    input::EventDispatcher dispatcher{&input};
+    int eventHandler = 0;
+    input::InputLog inputLog;
+    std::atomic<bool> replaying{false};
+    Uint64 tick = 0;
+    Uint64 seed = 0;
+    Uint32 instance = 0;
     double deltaTime = 0;
   
     std::thread renderThread;
     //std::thread eventThread;
-    bool running = false;
+    std::atomic<bool> running{false};
     bool closed = false;
+    bool headless = false;
     void (*_main)();
-    void (*_eventMain)(SDL_Event* event, float deltaTime);
+    void (*updateJobs)(jobs::JobGraph* graph, float deltaTime) = NULL;
+    jobs::JobGraph updateGraph;
   
   public:
 
@@ -103,8 +172,11 @@ namespace graphics {
      *  \param height Height of the Window
      *  \param title Name of the Window
      *  \param renderFrame Rectangle of Renderable positions
+     *  \param headless true to run without a display or renderer
+     *
+     *  \sa isHeadless()
      */
-    Window(int width, int height, const char* title, SDL_Rect renderFrame);
+    Window(int width, int height, const char* title, SDL_Rect renderFrame, bool headless = false);
 
     /**
      *  \brief Constructor of Window with custom color
@@ -114,8 +186,11 @@ namespace graphics {
      *  \param title Name of the Window
      *  \param renderFrame Rectangle of renderable positions
      *  \param bg Color of the Window background
+     *  \param headless true to run without a display or renderer
+     *
+     *  \sa isHeadless()
      */
-    Window(int width, int height, const char* title, SDL_Rect renderFrame, Color bg);
+    Window(int width, int height, const char* title, SDL_Rect renderFrame, Color bg, bool headless = false);
     ~Window();
 
 
@@ -163,6 +238,67 @@ namespace graphics {
      */
     void removeImage(ImageBase* image);
 
+    /**
+     *  \brief Function for adding a ParticleEmitter for rendering. It is
+     *         updated every tick before the frame is recorded
+     *
+     *  \param emitter Pointer to the ParticleEmitter to add
+     *
+     *  \sa removeEmitter()
+     */
+    void addEmitter(ParticleEmitter* emitter);
+
+    /**
+     *  \brief Function for removing a ParticleEmitter
+     *
+     *  \param emitter Pointer to the ParticleEmitter to remove
+     *
+     *  \sa addEmitter()
+     */
+    void removeEmitter(ParticleEmitter* emitter);
+
+    /**
+     *  \brief Mark a layer as static. Its images are kept in a texture
+     *         that is only drawn again where an image was added, removed,
+     *         moved or changed frame. Use for backgrounds, tilemaps and HUD
+     *         frames that rarely change. The render thread makes or
+     *         frees the cache when it draws the next frame
+     *
+     *  \param layer The layer eg. 0
+     *  \param isStatic false to draw the layer every frame again
+     */
+    void setLayerStatic(int layer, bool isStatic = true);
+
+
+
+    /**
+     *  \brief Function for adding an ecs::Registry for rendering. Its
+     *         entities are drawn after every ImageBase
+     *
+     *  \param registry Pointer to the ecs::Registry to add
+     *
+     *  \sa removeRegistry()
+     */
+    void addRegistry(ecs::Registry* registry);
+
+    /**
+     *  \brief Function for removing an ecs::Registry
+     *
+     *  \param registry Pointer to the ecs::Registry to remove
+     *
+     *  \sa addRegistry()
+     */
+    void removeRegistry(ecs::Registry* registry);
+
+    /**
+     *  \brief Get the World holding the images, cameras, registries and
+     *         clock of the window. It is made current on the thread
+     *         constructing the window
+     *
+     *  \return World* of the window
+     */
+    World* getWorld();
+
 
 
     /**
@@ -242,12 +378,77 @@ namespace graphics {
      */
     void setMainFunction(void (*_main)());
 
+    /**
+     *  \brief Set a function adding the jobs of the update phase, eg. AI,
+     *         physics and animation. It is called every tick after the
+     *         main function and the jobs are run across
+     *         jobs::ThreadPool::getDefault(), each starting once the jobs
+     *         it depends on are done
+     *
+     *  \param updateJobs Function given the JobGraph and the time of the
+     *         last tick in seconds
+     */
+    void setUpdateJobs(void (*updateJobs)(jobs::JobGraph* graph, float deltaTime));
+
+    /**
+     *  \brief Set a function adding render passes between drawing the world
+     *         and the Camera passes, eg. lighting or post processing. It is
+     *         called every frame and passes whose output is not used are
+     *         dropped
+     *
+     *  \param renderPasses Function given the RenderGraph and the world
+     *         target, returning the target the Camera passes should show
+     */
+    void setRenderPasses(RenderResource (*renderPasses)(RenderGraph* graph, RenderResource world));
+
+    /**
+     *  \brief Group the draws of each layer by texture. Faster, but
+     *         overlapping images on one layer may swap
+     *
+     *  \param sortByTexture true to group by texture
+     */
+    void setTextureSorting(bool sortByTexture);
+
+    /**
+     *  \brief Save the draw commands of the next frame to a file, to be
+     *         replayed with RenderCommandBuffer::load()
+     *
+     *  \param file The path to write to
+     */
+    void captureFrame(const char* file);
+
+    /**
+     *  \brief Set how many frames the simulation may finish before the
+     *         render thread draws them. The main loop waits once it is
+     *         that far ahead, so more gives smoother frame times and
+     *         less gives lower latency
+     *
+     *  \param maxFramesInFlight At least 1, 1 by default
+     */
+    void setMaxFramesInFlight(int maxFramesInFlight);
+
+    /**
+     *  \brief Get the time from starting to simulate the last drawn
+     *         frame to the end of drawing it
+     *
+     *  \return float of the latency in milliseconds
+     */
+    float getFrameLatency();
+
     /**
      *  \brief Set the event handler
      *
      *  \param _eventMain Event handler function declared by the user
      */
     void setEventHandler(void (*_eventMain)(SDL_Event* event, float deltaTime));
+
+    /**
+     *  \brief Get the dispatcher of the window's events, to subscribe to
+     *         event types instead of handling every event in one function
+     *
+     *  \return input::EventDispatcher* of the window
+     */
+    input::EventDispatcher* getEventDispatcher();
     
     /**
      *  \brief Check if window is closed
@@ -256,6 +457,22 @@ namespace graphics {
      */
     bool isClosed();
 
+    /**
+     *  \brief Close the window, ending startMainLoop()
+     */
+    void close();
+
+    /**
+     *  \brief Check if the window runs headless. A headless window has no
+     *         SDL window or renderer, so getRenderer() is NULL and assets
+     *         made with it get stub textures only knowing their size.
+     *         Nothing is drawn and startMainLoop() runs ticks as fast as
+     *         it can, each with a deltaTime of 1/fps
+     *
+     *  \return true if headless
+     */
+    bool isHeadless();
+
 
 
     /**
@@ -281,7 +498,7 @@ namespace graphics {
     double getDeltaTime();
 
     /**
-     *  \brief Check if key X is pressed
+     *  \brief Check if key X is held as of this tick
      *
      *  \param scancode SDL_Scancode of the key
      *
@@ -289,6 +506,109 @@ namespace graphics {
      */
     bool keyDown(SDL_Scancode scancode);
 
+    /**
+     *  \brief Check if key X went down this tick
+     *
+     *  \param scancode SDL_Scancode of the key
+     *
+     *  \return true only on the tick the key was pressed
+     */
+    bool keyPressed(SDL_Scancode scancode);
+
+    /**
+     *  \brief Check if key X went up this tick
+     *
+     *  \param scancode SDL_Scancode of the key
+     *
+     *  \return true only on the tick the key was released
+     */
+    bool keyReleased(SDL_Scancode scancode);
+
+    /**
+     *  \brief Get the input sampled for the main loop, eg. for the mouse
+     *
+     *  \return input::Input* of the window
+     */
+    input::Input* getInput();
+
+    /**
+     *  \brief Get the stats of the last frames shown, eg. draw calls,
+     *         culled images and frame time percentiles. Headless windows
+     *         only time their updates
+     *
+     *  \return FrameStatsRing* of the window
+     */
+    FrameStatsRing* getFrameStats();
+
+    /**
+     *  \brief Show a frame time graph and the counters of the last frame
+     *         over the window
+     *
+     *  \param show true to draw the overlay
+     */
+    void setStatsOverlay(bool show);
+
+    /**
+     *  \brief Record the input, deltaTime and seed of every following tick
+     *         to a file, to replay later with replayInput()
+     *
+     *  \param file The path of the log
+     *
+     *  \return true if recording
+     */
+    bool recordInput(const char* file);
+
+    /**
+     *  \brief Replay a log made by recordInput(). Live input is ignored
+     *         and each tick gets its recorded events, deltaTime and tick
+     *         number, with the recorded seed. Frames are not capped by the fps so a
+     *         replay runs as fast as it can, with SDL_VIDEODRIVER=dummy or
+     *         headless for benchmarking. The window closes when the log
+     *         ends
+     *
+     *  \param file The path of the log
+     *
+     *  \return true if the log was loaded
+     */
+    bool replayInput(const char* file);
+
+    /**
+     *  \brief Check if a log is being replayed
+     *
+     *  \return true if replaying
+     */
+    bool isReplaying();
+
+    /**
+     *  \brief Set the seed recorded with the input. Use getTickSeed() for
+     *         anything random so replays match
+     *
+     *  \param seed The seed
+     */
+    void setSeed(Uint64 seed);
+
+    /**
+     *  \brief Get the seed set or replayed
+     *
+     *  \return Uint64 of the seed
+     */
+    Uint64 getSeed();
+
+    /**
+     *  \brief Get the number of the current tick of startMainLoop()
+     *
+     *  \return Uint64 of the tick
+     */
+    Uint64 getTick();
+
+    /**
+     *  \brief Get a seed for the current tick, mixed from the seed and
+     *         the tick number
+     *
+     *  \return Uint64 of the seed
+     */
+    Uint64 getTickSeed();
+
 
 
     /**
@@ -0,0 +1,194 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file world.h
+ *
+ * A blackhole library class holding the state of one game instance
+ */
+
+#pragma once
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <SDL2/SDL.h>
+#include <list>
+#include "animation_system.h"
+#include "imageHolder.h"
+#include "cameraHolder.h"
+
+namespace blackhole {
+namespace ecs {
+  class Registry;
+}
+
+namespace graphics {
+
+  class ParticleEmitter;
+
+  /**
+   *  \brief Everything one instance of a game draws and animates: its
+   *         images, cameras, registries and clock. Worlds share nothing,
+   *         so many can be simulated at once on separate threads, each
+   *         in its own headless Window or stepped with update()
+   */
+  class World {
+  private:
+    std::list<ImageHolder> images;
+    std::list<ParticleEmitter*> emitters;
+    std::list<CameraHolder> cameras;
+    std::list<ecs::Registry*> registries;
+    AnimationSystem animations;
+  public:
+
+    /**
+     *  \brief The constructor of World
+     */
+    World();
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    /**
+     *  \brief Stops being current on the calling thread
+     */
+    ~World();
+
+    /**
+     *  \brief Make this the World of the calling thread, so Animations
+     *         and ecs::AnimatedPrototype made on it without an
+     *         AnimationSystem use this World's clock
+     *
+     *  \sa AnimationSystem::getDefault()
+     */
+    void makeCurrent();
+
+    /**
+     *  \brief Get the World of the calling thread
+     *
+     *  \return World* of the current World, NULL if none
+     */
+    static World* getCurrent();
+
+    /**
+     *  \brief Add an image, kept sorted by layer
+     *
+     *  \param image The image to add
+     */
+    void addImage(ImageBase* image);
+
+    /**
+     *  \brief Remove an image
+     *
+     *  \param image The image to remove
+     */
+    void removeImage(ImageBase* image);
+
+    /**
+     *  \brief Add a ParticleEmitter. It is drawn like an image and
+     *         updated by update()
+     *
+     *  \param emitter The ParticleEmitter to add
+     */
+    void addEmitter(ParticleEmitter* emitter);
+
+    /**
+     *  \brief Remove a ParticleEmitter
+     *
+     *  \param emitter The ParticleEmitter to remove
+     */
+    void removeEmitter(ParticleEmitter* emitter);
+
+    /**
+     *  \brief Add a Camera, kept sorted by layer
+     *
+     *  \param cam The Camera to add
+     */
+    void addCamera(Camera* cam);
+
+    /**
+     *  \brief Remove a Camera
+     *
+     *  \param cam The Camera to remove
+     */
+    void removeCamera(Camera* cam);
+
+    /**
+     *  \brief Add an ecs::Registry whose Renderable entities are drawn
+     *
+     *  \param registry The Registry to add
+     */
+    void addRegistry(ecs::Registry* registry);
+
+    /**
+     *  \brief Remove an ecs::Registry
+     *
+     *  \param registry The Registry to remove
+     */
+    void removeRegistry(ecs::Registry* registry);
+
+    /**
+     *  \brief Get the images in layer order
+     *
+     *  \return std::list of the images
+     */
+    std::list<ImageHolder>& getImages();
+
+    /**
+     *  \brief Get the cameras in layer order
+     *
+     *  \return std::list of the cameras
+     */
+    std::list<CameraHolder>& getCameras();
+
+    /**
+     *  \brief Get the registries
+     *
+     *  \return std::list of the registries
+     */
+    std::list<ecs::Registry*>& getRegistries();
+
+    /**
+     *  \brief Get the AnimationSystem playing the World's animations
+     *
+     *  \return AnimationSystem* of the World
+     */
+    AnimationSystem* getAnimationSystem();
+
+    /**
+     *  \brief Advance the clock of the World and update its emitters
+     *
+     *  \param time The time passed in seconds
+     */
+    void update(float time);
+
+    /**
+     *  \brief Get the time the World has been simulated for
+     *
+     *  \return double of seconds
+     */
+    double getClock();
+  };
+}}
+
+#endif
@@ -0,0 +1,174 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file event_dispatcher.h
+ *
+ * A blackhole library class for sending SDL events to handlers by type
+ */
+
+#pragma once
+#ifndef INPUT_EVENT_DISPATCHER_H
+#define INPUT_EVENT_DISPATCHER_H
+
+#include <SDL2/SDL.h>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "input.h"
+
+namespace blackhole {
+namespace input {
+
+  /**
+   *  \brief The type to subscribe to for every event
+   */
+  const Uint32 ALL_EVENTS = SDL_FIRSTEVENT;
+
+  /**
+   *  \brief A function handling an event
+   */
+  typedef std::function<void(SDL_Event* event, float deltaTime)> EventHandler;
+
+  /**
+   *  \brief Sends SDL events to the handlers subscribed to their type.
+   *         Started dispatchers share the SDL event filter, so events of
+   *         types none of them subscribed to are dropped before they are
+   *         queued. The
+   *         motion and wheel events of one poll can be merged into one
+   *         so a fast mouse costs a handler once per poll
+   */
+  class EventDispatcher {
+  private:
+    struct Subscriber {
+      int id;
+      EventHandler handler;
+    };
+
+    std::unordered_map<Uint32, std::vector<Subscriber>> subscribers;
+    std::unordered_map<Uint32, int> counts;
+    std::recursive_mutex mutex;
+    Input* input;
+    int nextId;
+    bool coalescing;
+    bool started;
+    bool removed;
+    bool hasMotion;
+    bool hasWheel;
+    SDL_Event motion;
+    SDL_Event wheel;
+
+    static int filter(void* userdata, SDL_Event* event);
+    void count(Uint32 type, int change);
+    void send(SDL_Event* event, float deltaTime);
+    void flushMotion(float deltaTime);
+    void flushWheel(float deltaTime);
+  public:
+
+    /**
+     *  \brief The constructor of EventDispatcher
+     *
+     *  \param input Given every keyboard and mouse event as it is
+     *         dispatched, so from the thread polling events, even those
+     *         nobody subscribed to. It should not be started as well. NULL
+     *         for none
+     */
+    EventDispatcher(Input* input = NULL);
+    EventDispatcher(const EventDispatcher&) = delete;
+    EventDispatcher& operator=(const EventDispatcher&) = delete;
+
+    /**
+     *  \brief Stops the dispatcher
+     */
+    ~EventDispatcher();
+
+    /**
+     *  \brief Add the dispatcher to the SDL event filter. SDL has one
+     *         filter for the process, so it is installed by the first
+     *         started dispatcher and keeps the events any started
+     *         dispatcher wants
+     */
+    void start();
+
+    /**
+     *  \brief Take the dispatcher out of the SDL event filter, which is
+     *         removed with the last started dispatcher
+     */
+    void stop();
+
+    /**
+     *  \brief Call a function for every event of a type
+     *
+     *  \param type The event type eg. SDL_KEYDOWN, or ALL_EVENTS
+     *  \param handler The function to call
+     *
+     *  \return int id to unsubscribe with
+     */
+    int subscribe(Uint32 type, EventHandler handler);
+
+    /**
+     *  \brief Stop calling a subscribed function
+     *
+     *  \param id The id from subscribe()
+     */
+    void unsubscribe(int id);
+
+    /**
+     *  \brief Merge the SDL_MOUSEMOTION and SDL_MOUSEWHEEL events of a
+     *         poll into one each. Motion keeps the last position and sums
+     *         the relative movement, wheel sums the scrolling
+     *
+     *  \param coalescing true to merge
+     */
+    void setCoalescing(bool coalescing);
+
+    /**
+     *  \brief Check if anything handles a type of event
+     *
+     *  \param type The event type
+     *
+     *  \return true if the type has subscribers
+     */
+    bool isWanted(Uint32 type);
+
+    /**
+     *  \brief Send an event to its subscribers
+     *
+     *  \param event The event
+     *  \param deltaTime Time passed in the frame
+     */
+    void dispatch(SDL_Event* event, float deltaTime);
+
+    /**
+     *  \brief Send the merged motion and wheel events. Call after the
+     *         events of a poll are dispatched
+     *
+     *  \param deltaTime Time passed in the frame
+     */
+    void flush(float deltaTime);
+  };
+}}
+
+#endif
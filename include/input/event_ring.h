@@ -0,0 +1,105 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file event_ring.h
+ *
+ * A blackhole library lock free queue between one producer and one consumer thread
+ */
+
+#pragma once
+#ifndef INPUT_EVENT_RING_H
+#define INPUT_EVENT_RING_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+
+namespace blackhole {
+namespace input {
+
+  /**
+   *  \brief A fixed size queue without locks for one thread pushing and
+   *         one thread popping. Pushing never waits, it fails when full
+   *
+   *  \tparam T The type of the items
+   *  \tparam CAPACITY The number of items, a power of 2
+   */
+  template<typename T, Uint32 CAPACITY>
+  class EventRing {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "EventRing capacity must be a power of 2");
+  private:
+    T items[CAPACITY];
+    // Written only by the consumer and producer respectively, kept apart
+    // so the two threads do not share a cache line
+    alignas(64) std::atomic<Uint32> head{0};
+    alignas(64) std::atomic<Uint32> tail{0};
+  public:
+
+    /**
+     *  \brief Add an item. Only call from the producer thread
+     *
+     *  \param item The item to add
+     *
+     *  \return true if added, false if the ring is full
+     */
+    bool push(const T& item) {
+      Uint32 at = tail.load(std::memory_order_relaxed);
+      if(at - head.load(std::memory_order_acquire) == CAPACITY) {
+        return false;
+      }
+      items[at & (CAPACITY - 1)] = item;
+      tail.store(at + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     *  \brief Take the oldest item. Only call from the consumer thread
+     *
+     *  \param item Set to the item taken
+     *
+     *  \return true if an item was taken, false if the ring is empty
+     */
+    bool pop(T& item) {
+      Uint32 at = head.load(std::memory_order_relaxed);
+      if(at == tail.load(std::memory_order_acquire)) {
+        return false;
+      }
+      item = items[at & (CAPACITY - 1)];
+      head.store(at + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     *  \brief Get the number of items waiting. Only exact on the consumer
+     *         thread
+     *
+     *  \return Uint32 of the number of items
+     */
+    Uint32 size() {
+      return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+  };
+}}
+
+#endif
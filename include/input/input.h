@@ -0,0 +1,217 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file input.h
+ *
+ * A blackhole library class for sampling keyboard and mouse input once per tick
+ */
+
+#pragma once
+#ifndef INPUT_INPUT_H
+#define INPUT_INPUT_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <vector>
+#include "event_ring.h"
+
+namespace blackhole {
+namespace input {
+
+  /**
+   *  \brief Flags of a key or button in an InputSnapshot
+   */
+  enum InputState {
+    INPUT_HELD = 1,  /**< Down at the end of the tick */
+    INPUT_PRESSED = 2,  /**< Went down during the tick */
+    INPUT_RELEASED = 4  /**< Went up during the tick */
+  };
+
+  /**
+   *  \brief An event and when SDL handed it to the library
+   */
+  struct InputEvent {
+    Uint64 time;  /**< SDL_GetPerformanceCounter() when it arrived */
+    SDL_Event event;  /**< The event */
+  };
+
+  /**
+   *  \brief The keyboard and mouse as of one tick
+   */
+  struct InputSnapshot {
+    Uint64 time;  /**< SDL_GetPerformanceCounter() when it was taken */
+    Uint8 keys[SDL_NUM_SCANCODES];  /**< InputState flags by scancode */
+    Uint8 buttons[8];  /**< InputState flags by SDL_BUTTON_* */
+    int mouseX;  /**< x of the mouse in the window */
+    int mouseY;  /**< y of the mouse in the window */
+    int wheelX;  /**< Horizontal wheel movement during the tick */
+    int wheelY;  /**< Vertical wheel movement during the tick */
+
+    /**
+     *  \brief Check if a key is held
+     *
+     *  \param scancode SDL_Scancode of the key
+     *
+     *  \return true if the key is down
+     */
+    bool keyDown(SDL_Scancode scancode) const;
+
+    /**
+     *  \brief Check if a key went down this tick
+     *
+     *  \param scancode SDL_Scancode of the key
+     *
+     *  \return true if the key was pressed
+     */
+    bool keyPressed(SDL_Scancode scancode) const;
+
+    /**
+     *  \brief Check if a key went up this tick
+     *
+     *  \param scancode SDL_Scancode of the key
+     *
+     *  \return true if the key was released
+     */
+    bool keyReleased(SDL_Scancode scancode) const;
+
+    /**
+     *  \brief Check if a mouse button is held
+     *
+     *  \param button The button eg. SDL_BUTTON_LEFT
+     *
+     *  \return true if the button is down
+     */
+    bool buttonDown(int button) const;
+
+    /**
+     *  \brief Check if a mouse button went down this tick
+     *
+     *  \param button The button eg. SDL_BUTTON_LEFT
+     *
+     *  \return true if the button was pressed
+     */
+    bool buttonPressed(int button) const;
+
+    /**
+     *  \brief Check if a mouse button went up this tick
+     *
+     *  \param button The button eg. SDL_BUTTON_LEFT
+     *
+     *  \return true if the button was released
+     */
+    bool buttonReleased(int button) const;
+  };
+
+  /**
+   *  \brief Keyboard and mouse events timestamped as SDL receives them
+   *         and queued in a lock free ring, read by the update thread
+   *         into one InputSnapshot per tick. The thread pumping SDL
+   *         events is the only producer and the thread calling update()
+   *         the only consumer
+   */
+  class Input {
+  private:
+    EventRing<InputEvent, 1024> ring;
+    InputSnapshot snapshot;
+    std::vector<InputEvent> events;
+    std::atomic<int> dropped;
+    bool watching;
+
+    static int watch(void* userdata, SDL_Event* event);
+    void clearEdges();
+    void apply(const InputEvent& input);
+  public:
+
+    /**
+     *  \brief The constructor of Input
+     */
+    Input();
+    Input(const Input&) = delete;
+    Input& operator=(const Input&) = delete;
+
+    /**
+     *  \brief Stops watching SDL events
+     */
+    ~Input();
+
+    /**
+     *  \brief Start receiving events from SDL as they are pumped
+     */
+    void start();
+
+    /**
+     *  \brief Stop receiving events from SDL
+     */
+    void stop();
+
+    /**
+     *  \brief Queue an event. Only call from the producer thread
+     *
+     *  \param event The event. Only keyboard and mouse events are kept
+     *
+     *  \return false if the ring was full and the event dropped
+     */
+    bool push(const SDL_Event* event);
+
+    /**
+     *  \brief Take the queued events and update the snapshot. Call once
+     *         at the start of every tick
+     */
+    void update();
+
+    /**
+     *  \brief Update the snapshot from recorded events instead of the
+     *         queued ones, which are discarded. Call once at the start of
+     *         every tick in place of update()
+     *
+     *  \param events The events of the tick eg. from InputLog
+     */
+    void replay(const std::vector<InputEvent>& events);
+
+    /**
+     *  \brief Get the snapshot of the last update()
+     *
+     *  \return const InputSnapshot* of the snapshot
+     */
+    const InputSnapshot* getSnapshot();
+
+    /**
+     *  \brief Get the events taken by the last update() in the order
+     *         they arrived
+     *
+     *  \return std::vector of the events
+     */
+    const std::vector<InputEvent>& getEvents();
+
+    /**
+     *  \brief Get the number of events dropped because the ring was full
+     *
+     *  \return int of the dropped events
+     */
+    int getDropped();
+  };
+}}
+
+#endif
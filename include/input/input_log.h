@@ -0,0 +1,156 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file input_log.h
+ *
+ * A blackhole library class for recording and replaying the input of every tick
+ */
+
+#pragma once
+#ifndef INPUT_INPUT_LOG_H
+#define INPUT_INPUT_LOG_H
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <vector>
+#include "input.h"
+
+namespace blackhole {
+namespace input {
+
+  /**
+   *  \brief A binary log of the input events of every tick, with the tick
+   *         number, its deltaTime and the seed of the session. Replaying
+   *         the log gives a game the same ticks with the same input, so a
+   *         recorded session can be run again as fast as possible
+   */
+  class InputLog {
+  private:
+    struct Tick {
+      Uint64 tick;
+      double deltaTime;
+      Uint32 firstEvent;
+      Uint32 numEvents;
+    };
+
+    FILE* out;
+    std::vector<Tick> ticks;
+    std::vector<InputEvent> events;
+    std::vector<InputEvent> replayed;
+    size_t position;
+    Uint64 seed;
+  public:
+
+    /**
+     *  \brief The constructor of InputLog
+     */
+    InputLog();
+    InputLog(const InputLog&) = delete;
+    InputLog& operator=(const InputLog&) = delete;
+
+    /**
+     *  \brief Closes the log being recorded
+     */
+    ~InputLog();
+
+    /**
+     *  \brief Start recording to a file
+     *
+     *  \param file The path to write to
+     *  \param seed The seed of the session, given back by getSeed() on
+     *         replay
+     *
+     *  \return true if the file was opened
+     */
+    bool record(const char* file, Uint64 seed);
+
+    /**
+     *  \brief Add a tick to the log being recorded
+     *
+     *  \param tick The number of the tick
+     *  \param deltaTime The time of the tick in seconds
+     *  \param events The events of the tick from Input::getEvents()
+     */
+    void writeTick(Uint64 tick, double deltaTime, const std::vector<InputEvent>& events);
+
+    /**
+     *  \brief Load a recorded log to replay, stopping any recording. A log
+     *         that ends part way through a tick keeps the complete ticks
+     *         before it
+     *
+     *  \param file The path to read from
+     *
+     *  \return true on success
+     */
+    bool load(const char* file);
+
+    /**
+     *  \brief Give the next recorded tick to an Input with
+     *         Input::replay()
+     *
+     *  \param input The Input to update
+     *  \param deltaTime Set to the deltaTime of the tick
+     *  \param tickNumber Set to the number the tick was recorded with
+     *
+     *  \return false once every tick has been replayed
+     */
+    bool readTick(Input* input, double* deltaTime, Uint64* tickNumber);
+
+    /**
+     *  \brief Stop recording or replaying
+     */
+    void close();
+
+    /**
+     *  \brief Check if ticks are being recorded
+     *
+     *  \return true if recording
+     */
+    bool isRecording();
+
+    /**
+     *  \brief Check if a log is loaded with ticks left to replay
+     *
+     *  \return true if replaying
+     */
+    bool isReplaying();
+
+    /**
+     *  \brief Get the seed of the recorded or replayed session
+     *
+     *  \return Uint64 of the seed
+     */
+    Uint64 getSeed();
+
+    /**
+     *  \brief Get the number of ticks in the loaded log
+     *
+     *  \return int of the number of ticks
+     */
+    int getTickCount();
+  };
+}}
+
+#endif
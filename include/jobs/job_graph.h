@@ -0,0 +1,119 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file job_graph.h
+ *
+ * A blackhole library class for running jobs that depend on each other
+ */
+
+#pragma once
+#ifndef JOBS_JOB_GRAPH_H
+#define JOBS_JOB_GRAPH_H
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+#include "thread_pool.h"
+
+namespace blackhole {
+namespace jobs {
+
+  /**
+   *  \brief A job added to a JobGraph
+   */
+  typedef int JobId;
+
+  /**
+   *  \brief A list of jobs and the jobs they wait for. On execute() every
+   *         job starts as soon as the last of its dependencies finishes,
+   *         so jobs that do not depend on each other run at the same time
+   */
+  class JobGraph {
+  private:
+    struct Job {
+      const char* name;
+      std::function<void()> execute;
+      std::vector<JobId> dependents;
+      int dependencies;
+      std::atomic<int> pending;
+    };
+
+    std::vector<std::unique_ptr<Job>> jobs;
+    ThreadPool* pool = NULL;
+
+    void schedule(JobId id, std::atomic<int>* counter);
+  public:
+
+    /**
+     *  \brief Add a job
+     *
+     *  \param name The name of the job eg. physics
+     *  \param dependencies The jobs that must finish first. Only jobs
+     *         already added, so the graph can not loop
+     *  \param execute The function run by the job
+     *
+     *  \return JobId of the job
+     */
+    JobId addJob(const char* name, std::initializer_list<JobId> dependencies, std::function<void()> execute);
+
+    /**
+     *  \brief Add a job splitting a range across the pool with
+     *         ThreadPool::parallelFor()
+     *
+     *  \param name The name of the job eg. animation
+     *  \param dependencies The jobs that must finish first
+     *  \param count The size of the range eg. the number of entities
+     *  \param grain The smallest chunk worth a task
+     *  \param execute Called with the begin and end of each chunk
+     *
+     *  \return JobId of the job
+     */
+    JobId addParallelFor(const char* name, std::initializer_list<JobId> dependencies, int count, int grain, std::function<void(int begin, int end)> execute);
+
+    /**
+     *  \brief Run every job, returning once all of them are done, and
+     *         clear the graph for the next frame
+     *
+     *  \param pool The ThreadPool to run the jobs on
+     */
+    void execute(ThreadPool* pool = ThreadPool::getDefault());
+
+    /**
+     *  \brief Remove every job without running them
+     */
+    void clear();
+
+    /**
+     *  \brief Get the number of jobs added
+     *
+     *  \return int of the number of jobs
+     */
+    int getCount();
+  };
+}}
+
+#endif
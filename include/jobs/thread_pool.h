@@ -0,0 +1,139 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file thread_pool.h
+ *
+ * A blackhole library work stealing pool of worker threads
+ */
+
+#pragma once
+#ifndef JOBS_THREAD_POOL_H
+#define JOBS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace blackhole {
+namespace jobs {
+
+  /**
+   *  \brief A pool of worker threads. Every worker has its own queue that
+   *         it takes work from the back of, and idle workers steal from
+   *         the front of the others, so work spreads without one shared
+   *         queue. Threads waiting on the pool run tasks while they wait
+   */
+  class ThreadPool {
+  private:
+    struct Worker {
+      std::deque<std::function<void()>> tasks;
+      std::mutex mutex;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::atomic<bool> running;
+    std::atomic<int> queued;
+    std::atomic<unsigned> nextWorker;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    bool pop(int worker, std::function<void()>& task);
+    bool steal(int worker, std::function<void()>& task);
+    void workerLoop(int worker);
+  public:
+
+    /**
+     *  \brief The constructor of ThreadPool
+     *
+     *  \param threads The number of worker threads. 0 for one less than
+     *         the number of cores, leaving one for the thread submitting
+     */
+    ThreadPool(int threads = 0);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     *  \brief Finishes the queued tasks and joins the workers
+     */
+    ~ThreadPool();
+
+    /**
+     *  \brief Get the ThreadPool shared by the library
+     *
+     *  \return ThreadPool* of the default pool
+     */
+    static ThreadPool* getDefault();
+
+    /**
+     *  \brief Queue a task
+     *
+     *  \param task The function to run
+     *  \param counter Incremented now and decremented once the task has
+     *         run. NULL for none
+     *
+     *  \sa wait()
+     */
+    void submit(std::function<void()> task, std::atomic<int>* counter = NULL);
+
+    /**
+     *  \brief Run one queued task on the calling thread
+     *
+     *  \return true if a task was run
+     */
+    bool runOne();
+
+    /**
+     *  \brief Run tasks on the calling thread until a counter reaches 0
+     *
+     *  \param counter The counter given to submit()
+     */
+    void wait(std::atomic<int>* counter);
+
+    /**
+     *  \brief Run a function over a range split into chunks across the
+     *         pool, returning once every chunk is done
+     *
+     *  \param count The size of the range
+     *  \param grain The smallest chunk worth a task
+     *  \param function Called with the begin and end of each chunk
+     */
+    void parallelFor(int count, int grain, const std::function<void(int begin, int end)>& function);
+
+    /**
+     *  \brief Get the number of worker threads
+     *
+     *  \return int of the number of workers
+     */
+    int getThreadCount();
+  };
+}}
+
+#endif
@@ -0,0 +1,83 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file components.cpp
+ *
+ * A blackhole library set of built in components for ecs::Registry
+ */
+
+#include "ecs/components.h"
+#include <stdio.h>
+
+namespace blackhole::ecs {
+
+  Renderable makeRenderable(graphics::ImageBase* image) {
+    graphics::SpriteRecord* record = image->getRecord();
+    SDL_Rect* destRect = image->getDestRect();
+    SDL_Rect* srcRect = image->getSrcRect();
+    Renderable renderable = {
+      image->getTexture(),
+      {0, 0, 0, 0},
+      destRect->w,
+      destRect->h,
+      record->flip,
+      srcRect != NULL
+    };
+    if(srcRect != NULL) {
+      renderable.src = *srcRect;
+    }
+    return renderable;
+  }
+
+  AnimatedPrototype::AnimatedPrototype(graphics::SpriteSheet* sheet, int* frames, int num_frames, float speed, graphics::AnimationSystem* system) {
+    if(system == NULL) {
+      system = graphics::AnimationSystem::getDefault();
+    }
+    if(frames == NULL || num_frames < 1) {
+      printf("Animated has no frames, showing frame 0\n");
+      frames = NULL;
+      num_frames = 0;
+    }
+    // Grid sheets have no durations, which would stop on the last frame
+    if(speed <= 0) {
+      for(int i = 0; i < num_frames; i++) {
+        if(sheet->getFrameDuration(frames[i]) <= 0) {
+          speed = 0.1f;
+          break;
+        }
+      }
+    }
+    animated.system = system;
+    animated.slot = system->create(sheet, frames, num_frames, speed, frames != NULL ? frames[0] : 0);
+  }
+
+  AnimatedPrototype::~AnimatedPrototype() {
+    animated.system->destroy(animated.slot);
+  }
+
+  const Animated& AnimatedPrototype::get() const {
+    return animated;
+  }
+}
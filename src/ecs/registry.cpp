@@ -0,0 +1,144 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file registry.cpp
+ *
+ * A blackhole library class owning entities and their components
+ */
+
+#include "ecs/registry.h"
+
+namespace blackhole::ecs {
+
+  Registry::Registry(int capacity) {
+    count = 0;
+    reserve(capacity);
+  }
+
+  Registry::~Registry() {
+    clear();
+  }
+
+  void Registry::reserve(int capacity) {
+    entities.reserve(capacity);
+    alive.reserve(capacity);
+    freeIndices.reserve(capacity);
+    transforms.reserve(capacity, capacity);
+    velocities.reserve(capacity, capacity);
+    layers.reserve(capacity, capacity);
+    renderables.reserve(capacity, capacity);
+    animations.reserve(capacity, capacity);
+  }
+
+  Entity Registry::create() {
+    count++;
+    if(!freeIndices.empty()) {
+      Uint32 index = freeIndices.back();
+      freeIndices.pop_back();
+      alive[index] = true;
+      return entities[index];
+    }
+    if(entities.size() > ENTITY_INDEX_MASK) {
+      printf("Too many entities in Registry\n");
+      count--;
+      return NULL_ENTITY;
+    }
+    Entity entity = entities.size();
+    entities.push_back(entity);
+    alive.push_back(true);
+    return entity;
+  }
+
+  void Registry::create(Entity* entities, int count) {
+    for(int i = 0; i < count; i++) {
+      entities[i] = create();
+    }
+  }
+
+  void Registry::release(Entity entity) {
+    transforms.remove(entity);
+    velocities.remove(entity);
+    layers.remove(entity);
+    renderables.remove(entity);
+    remove<Animated>(entity);
+
+    // Bump the version so old handles to this index are no longer valid
+    Uint32 index = entityIndex(entity);
+    Uint32 version = (entityVersion(entity) + 1) & 0xFF;
+    if(version == 0xFF) {
+      version = 0;
+    }
+    entities[index] = (version << ENTITY_INDEX_BITS) | index;
+    alive[index] = false;
+    freeIndices.push_back(index);
+    count--;
+  }
+
+  void Registry::destroy(Entity entity) {
+    if(valid(entity)) {
+      release(entity);
+    }
+  }
+
+  void Registry::destroy(const Entity* entities, int count) {
+    for(int i = 0; i < count; i++) {
+      destroy(entities[i]);
+    }
+  }
+
+  void Registry::clear() {
+    for(Uint32 i = 0; i < entities.size(); i++) {
+      if(valid(entities[i])) {
+        release(entities[i]);
+      }
+    }
+  }
+
+  bool Registry::valid(Entity entity) {
+    Uint32 index = entityIndex(entity);
+    return index < entities.size() && alive[index] && entities[index] == entity;
+  }
+
+  int Registry::getCount() {
+    return count;
+  }
+
+  template<> Animated* Registry::add<Animated>(Entity entity, const Animated& component) {
+    remove<Animated>(entity);
+    Animated animated = {
+      component.system,
+      component.system->clone(component.slot)
+    };
+    return animations.add(entity, animated);
+  }
+
+  template<> void Registry::remove<Animated>(Entity entity) {
+    Animated* animated = animations.get(entity);
+    if(animated != NULL) {
+      animated->system->destroy(animated->slot);
+      animations.remove(entity);
+    }
+  }
+}
@@ -0,0 +1,173 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file systems.cpp
+ *
+ * A blackhole library set of systems walking the components of an ecs::Registry
+ */
+
+#include "ecs/systems.h"
+#include "graphics/sprite_record.h"
+#include "graphics/render_command_buffer.h"
+
+namespace blackhole::ecs {
+
+  // Entities per task, small ranges cost more to queue than to move
+  static const int INTEGRATE_GRAIN = 4096;
+
+  void integrate(Registry* registry, float time, jobs::ThreadPool* pool) {
+    SparseSet<Velocity>* velocities = registry->getComponents<Velocity>();
+    SparseSet<Transform>* transforms = registry->getComponents<Transform>();
+    Entity* entities = velocities->getEntities();
+    Velocity* velocity = velocities->getComponents();
+    int count = velocities->size();
+    // Every entity owns its Transform so ranges never write the same one
+    auto move = [=](int begin, int end) {
+      for(int i = begin; i < end; i++) {
+        Transform* transform = transforms->get(entities[i]);
+        if(transform != NULL) {
+          transform->x += velocity[i].x * time;
+          transform->y += velocity[i].y * time;
+        }
+      }
+    };
+    if(pool == NULL) {
+      move(0, count);
+    }
+    else {
+      pool->parallelFor(count, INTEGRATE_GRAIN, move);
+    }
+  }
+
+  void sortByLayer(Registry* registry) {
+    SparseSet<Layer>* layers = registry->getComponents<Layer>();
+    registry->getComponents<Renderable>()->sort([layers](Entity first, Entity second) {
+      Layer* firstLayer = layers->get(first);
+      Layer* secondLayer = layers->get(second);
+      return (firstLayer ? firstLayer->layer : 0) < (secondLayer ? secondLayer->layer : 0);
+    });
+  }
+
+  // Fills in the record of an entity, false if it has no Transform
+  static bool buildRecord(SparseSet<Transform>* transforms, SparseSet<Animated>* animations, Entity entity, Renderable* renderable, graphics::SpriteRecord* record) {
+    Transform* transform = transforms->get(entity);
+    if(transform == NULL) {
+      return false;
+    }
+    record->texture = renderable->texture;
+    record->src = renderable->src;
+    record->flip = renderable->flip;
+    record->hasSrc = renderable->hasSrc;
+    record->origin = {transform->x, transform->y};
+    record->dest = {transform->x, transform->y, (float)renderable->w, (float)renderable->h};
+    record->animation = NULL;
+
+    // Animated entities are culled with the frame of the last draw so
+    // culled animations are never evaluated
+    Animated* animated = animations->get(entity);
+    if(animated != NULL) {
+      SDL_Rect* src = animated->system->getLastSrcRect(animated->slot);
+      SDL_Point* offset = animated->system->getDestOffset(animated->slot);
+      record->dest = {transform->x + offset->x, transform->y + offset->y, (float)src->w, (float)src->h};
+      record->animation = animated->system;
+      record->animationSlot = animated->slot;
+      record->hasSrc = true;
+    }
+    return true;
+  }
+
+  static bool isVisible(graphics::SpriteRecord* record, const SDL_Rect* viewports, int num_viewports) {
+    SDL_Rect* bounds = graphics::getRecordDestRect(record);
+    bool visible = num_viewports == 0;
+    for(int j = 0; j < num_viewports && !visible; j++) {
+      visible = SDL_HasIntersection(&viewports[j], bounds);
+    }
+    return visible;
+  }
+
+  void drawRenderables(Registry* registry, SDL_Renderer* renderer, const SDL_Rect* viewports, int num_viewports, graphics::FrameStats* stats) {
+    SparseSet<Renderable>* renderables = registry->getComponents<Renderable>();
+    SparseSet<Transform>* transforms = registry->getComponents<Transform>();
+    SparseSet<Animated>* animations = registry->getComponents<Animated>();
+    Entity* entities = renderables->getEntities();
+    Renderable* renderable = renderables->getComponents();
+    int count = renderables->size();
+
+    graphics::SpriteRecord record;
+    record.custom = NULL;
+    record.transform = NULL;
+    SDL_Texture* bound = NULL;
+    for(int i = 0; i < count; i++) {
+      if(!buildRecord(transforms, animations, entities[i], &renderable[i], &record)) {
+        continue;
+      }
+      bool visible = isVisible(&record, viewports, num_viewports);
+      if(visible) {
+        graphics::drawRecord(renderer, &record);
+      }
+      if(stats == NULL) {
+        continue;
+      }
+      if(!visible) {
+        stats->culled++;
+        continue;
+      }
+      stats->drawn++;
+      stats->drawCalls++;
+      if(record.texture != bound) {
+        stats->textureBinds++;
+        bound = record.texture;
+      }
+    }
+  }
+
+  void recordRenderables(Registry* registry, graphics::RenderCommandBuffer* commands, int layer, const SDL_Rect* viewports, int num_viewports, graphics::FrameStats* stats) {
+    SparseSet<Renderable>* renderables = registry->getComponents<Renderable>();
+    SparseSet<Transform>* transforms = registry->getComponents<Transform>();
+    SparseSet<Animated>* animations = registry->getComponents<Animated>();
+    Entity* entities = renderables->getEntities();
+    Renderable* renderable = renderables->getComponents();
+    int count = renderables->size();
+
+    graphics::SpriteRecord record;
+    record.custom = NULL;
+    record.transform = NULL;
+    for(int i = 0; i < count; i++) {
+      if(!buildRecord(transforms, animations, entities[i], &renderable[i], &record)) {
+        continue;
+      }
+      if(isVisible(&record, viewports, num_viewports)) {
+        commands->add(&record, layer);
+        if(stats != NULL) {
+          stats->drawn++;
+        }
+      }
+      else if(stats != NULL) {
+        stats->culled++;
+      }
+    }
+  }
+
+}
@@ -32,67 +32,119 @@
 
 namespace blackhole::graphics {
 
-  Animation::Animation(SpriteSheet* images, int frame, int* frames, int num_frames, float speed)
+  Animation::Animation(SpriteSheet* images, int frame, int* frames, int num_frames, float speed, AnimationSystem* system)
   {
-    this->images = images;
-    images->setFrame(frame);
-    this->frames = frames;
-    this->num_frames = num_frames;
-    printf("%d\n", num_frames);
-    this->speed = speed;
+    this->system = system != NULL ? system : AnimationSystem::getDefault();
+    this->id = this->system->create(images, frames, num_frames, speed, frame);
+    this->x = images->getX();
+    this->y = images->getY();
+
+    setCustomDraw(false);
+    record.hasSrc = true;
+    record.texture = images->getTexture();
+    record.animation = this->system;
+    record.animationSlot = this->id;
+    updateRecord();
   }
 
-  Animation::~Animation() {
+  Animation::Animation(const Animation& animation) : ImageBase(animation) {
+    system = animation.system;
+    id = system->clone(animation.id);
+    x = animation.x;
+    y = animation.y;
+    record.animationSlot = id;
+  }
 
+  Animation& Animation::operator=(const Animation& animation) {
+    if(this != &animation) {
+      ImageBase::operator=(animation);
+      system->destroy(id);
+      system = animation.system;
+      id = system->clone(animation.id);
+      x = animation.x;
+      y = animation.y;
+      record.animationSlot = id;
+    }
+    return *this;
+  }
+
+  Animation::~Animation() {
+    system->destroy(id);
   }
 
   void Animation::setX(float x) {
-    images->setX(x);
+    this->x = x;
+    updateRecord();
   }
 
   void Animation::setY(float y) {
-    images->setY(y);
+    this->y = y;
+    updateRecord();
+  }
+
+  void Animation::updateRecord() {
+    record.origin = {x, y};
+    record.src = *system->getLastSrcRect(id);
+    record.dest = {
+      x + system->getDestOffset(id)->x,
+      y + system->getDestOffset(id)->y,
+      (float)record.src.w,
+      (float)record.src.h
+    };
   }
   
   float Animation::getX() {
-    return images->getX();
+    return x;
   }
 
   float Animation::getY() {
-    return images->getY();
+    return y;
   }
 
   void  Animation::setFrame(int frame) {
-    images->setFrame(frame);
+    system->setFrame(id, frame);
+    updateRecord();
   }
 
   int Animation::getFrame() {
-    return images->getFrame();
+    return system->getFrame(id);
   }
 
   void Animation::resetAnimation() {
-    this->time = 0;
-  }
-  
-  void Animation::addTime(float time) {
-    this->time += time;
-    images->setFrame(frames[(int)(this->time / speed) % num_frames]);
+    system->reset(id);
+    updateRecord();
   }
 
   SpriteSheet* Animation::getSpriteSheet() {
-    return images;
+    return system->getSpriteSheet(id);
+  }
+
+  AnimationSystem* Animation::getAnimationSystem() {
+    return system;
+  }
+
+  int Animation::getSlot() {
+    return id;
   }
 
   SDL_Texture* Animation::getTexture() {
-    return images->getTexture();
+    return getSpriteSheet()->getTexture();
   }
   
   SDL_Rect* Animation::getSrcRect() {
-    return images->getSrcRect();
+    return system->getSrcRect(id);
   }
 
   SDL_Rect* Animation::getDestRect() {
-    return images->getDestRect();
+    // Read without evaluating so culling an Animation is free. Window
+    // reads getSrcRect() first when it draws
+    SDL_Rect* srcRect = system->getLastSrcRect(id);
+    SDL_Point* offset = system->getDestOffset(id);
+    destRect.x = round(x) + offset->x;
+    destRect.y = round(y) + offset->y;
+    destRect.w = srcRect->w;
+    destRect.h = srcRect->h;
+    return &destRect;
   }
 
 }
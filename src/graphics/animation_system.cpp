@@ -0,0 +1,321 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file animation_system.cpp
+ *
+ * A blackhole library class for advancing every Animation in one pass
+ */
+
+#include "graphics/animation_system.h"
+#include "graphics/world.h"
+#include "graphics/animator_controller.h"
+#include <algorithm>
+#include <stdio.h>
+
+namespace blackhole::graphics {
+
+  AnimationSystem::AnimationSystem() {
+  }
+
+  AnimationSystem::~AnimationSystem() {
+  }
+
+  AnimationSystem* AnimationSystem::getDefault() {
+    World* world = World::getCurrent();
+    if(world != NULL) {
+      return world->getAnimationSystem();
+    }
+    // Nothing updates this system, so anything using it would be frozen
+    static thread_local bool warned = false;
+    if(!warned) {
+      printf("No World is current on this thread so animations will not advance. "
+             "Create the Window first or call World::makeCurrent()\n");
+      warned = true;
+    }
+    static AnimationSystem system;
+    return &system;
+  }
+
+  int AnimationSystem::allocate() {
+    if(!freeSlots.empty()) {
+      int id = freeSlots.back();
+      freeSlots.pop_back();
+      return id;
+    }
+    start.push_back(0);
+    speed.push_back(0);
+    inverseSpeed.push_back(0);
+    duration.push_back(0);
+    inverseDuration.push_back(0);
+    frameOffset.push_back(0);
+    frameCount.push_back(0);
+    evaluated.push_back(0);
+    elapsed.push_back(0);
+    step.push_back(0);
+    frame.push_back(0);
+    srcRect.push_back({0, 0, 0, 0});
+    destOffset.push_back({0, 0});
+    sheets.push_back(NULL);
+    return start.size() - 1;
+  }
+
+  int AnimationSystem::allocateFrames(int count) {
+    // First fit in the ranges of destroyed animations, keeping the rest
+    for(size_t i = 0; i < freeRanges.size(); i++) {
+      FrameRange& range = freeRanges[i];
+      if(range.count < count) {
+        continue;
+      }
+      int offset = range.offset;
+      range.offset += count;
+      range.count -= count;
+      if(range.count == 0) {
+        freeRanges.erase(freeRanges.begin() + i);
+      }
+      return offset;
+    }
+    int offset = frameTable.size();
+    frameTable.resize(offset + count);
+    frameRects.resize(offset + count);
+    frameDestOffsets.resize(offset + count);
+    frameEnds.resize(offset + count);
+    rangeUsers.resize(offset + count, 0);
+    return offset;
+  }
+
+  void AnimationSystem::releaseFrames(int offset, int count) {
+    // Kept sorted and merged with its neighbours so churn does not
+    // split the table into ranges too small to reuse
+    auto next = std::lower_bound(freeRanges.begin(), freeRanges.end(), offset, [](const FrameRange& range, int offset) {
+      return range.offset < offset;
+    });
+    next = freeRanges.insert(next, {offset, count});
+    if(next + 1 != freeRanges.end() && next->offset + next->count == (next + 1)->offset) {
+      next->count += (next + 1)->count;
+      freeRanges.erase(next + 1);
+    }
+    if(next != freeRanges.begin() && (next - 1)->offset + (next - 1)->count == next->offset) {
+      (next - 1)->count += next->count;
+      freeRanges.erase(next);
+    }
+  }
+
+  int AnimationSystem::create(SpriteSheet* sheet, const int* frames, int num_frames, float speed, int frame) {
+    if(frames == NULL || num_frames < 1) {
+      frames = &frame;
+      num_frames = 1;
+    }
+    // Clones share the range, which is freed with its last user
+    int offset = allocateFrames(num_frames);
+    rangeUsers[offset] = 1;
+
+    // Frames end at a running total of their durations so frames that
+    // are shown for different lengths of time share one lookup
+    float end = 0;
+    for(int i = 0; i < num_frames; i++) {
+      end += speed > 0 ? speed : sheet->getFrameDuration(frames[i]);
+      frameTable[offset + i] = frames[i];
+      frameRects[offset + i] = sheet->getFrameRect(frames[i]);
+      frameDestOffsets[offset + i] = sheet->getFrameOffset(frames[i]);
+      frameEnds[offset + i] = end;
+    }
+
+    int id = allocate();
+    start[id] = clock;
+    frameOffset[id] = offset;
+    frameCount[id] = num_frames;
+    step[id] = 0;
+    sheets[id] = sheet;
+    setTiming(id, speed > 0 ? speed : 0, end);
+    setFrame(id, frame);
+    return id;
+  }
+
+  int AnimationSystem::clone(int id) {
+    int copy = allocate();
+    start[copy] = start[id];
+    frameOffset[copy] = frameOffset[id];
+    frameCount[copy] = frameCount[id];
+    rangeUsers[frameOffset[id]]++;
+    evaluated[copy] = evaluated[id];
+    elapsed[copy] = elapsed[id];
+    step[copy] = step[id];
+    frame[copy] = frame[id];
+    srcRect[copy] = srcRect[id];
+    destOffset[copy] = destOffset[id];
+    sheets[copy] = sheets[id];
+    setTiming(copy, speed[id], duration[id]);
+    return copy;
+  }
+
+  void AnimationSystem::destroy(int id) {
+    if(sheets[id] == NULL) {
+      return;
+    }
+    if(--rangeUsers[frameOffset[id]] == 0) {
+      releaseFrames(frameOffset[id], frameCount[id]);
+    }
+    // A freed slot stays in the arrays frozen on its first frame so
+    // evaluateAll() never has to branch around it. Its range may be
+    // reused, which only changes the frame it is frozen on
+    setTiming(id, 0, 0);
+    step[id] = 0;
+    frameCount[id] = 1;
+    sheets[id] = NULL;
+    freeSlots.push_back(id);
+  }
+
+  void AnimationSystem::setTiming(int id, float speed, float duration) {
+    this->speed[id] = speed;
+    this->duration[id] = duration;
+    inverseSpeed[id] = speed > 0 ? 1/speed : 0;
+    inverseDuration[id] = duration > 0 ? 1.0/duration : 0;
+  }
+
+  void AnimationSystem::addController(AnimatorController* controller) {
+    controllers.push_back(controller);
+  }
+
+  void AnimationSystem::removeController(AnimatorController* controller) {
+    controllers.erase(std::remove(controllers.begin(), controllers.end(), controller), controllers.end());
+  }
+
+  void AnimationSystem::update(float time) {
+    clock += time;
+    tick++;
+
+    for(AnimatorController* controller : controllers) {
+      controller->evaluate();
+    }
+  }
+
+  double AnimationSystem::getClock() {
+    return clock;
+  }
+
+  void AnimationSystem::gather(int id) {
+    // Uniform frames already have the right step. Frames with their own
+    // durations start from 0 and walk the running total
+    int index = frameOffset[id] + step[id];
+    int last = frameOffset[id] + frameCount[id] - 1;
+    while(index < last && frameEnds[index] <= elapsed[id]) {
+      index++;
+    }
+    step[id] = index - frameOffset[id];
+    frame[id] = frameTable[index];
+    srcRect[id] = frameRects[index];
+    destOffset[id] = frameDestOffsets[index];
+    evaluated[id] = tick;
+  }
+
+  void AnimationSystem::evaluate(int id) {
+    if(evaluated[id] == tick) {
+      return;
+    }
+    // Time is wrapped to the length of the animation before it becomes a
+    // float which keeps the precision from drifting on long running clocks
+    double time = clock - start[id];
+    float now = time - duration[id]*(Sint64)(time*inverseDuration[id]);
+    int current = (int)(now*inverseSpeed[id]);
+    elapsed[id] = now;
+    step[id] = current < frameCount[id] ? current : frameCount[id] - 1;
+    gather(id);
+  }
+
+  void AnimationSystem::evaluateAll() {
+    int size = start.size();
+    const double* begin = start.data();
+    const float* invSpeed = inverseSpeed.data();
+    const double* dur = duration.data();
+    const double* invDur = inverseDuration.data();
+    const int* count = frameCount.data();
+    float* t = elapsed.data();
+    int* s = step.data();
+
+    // Branch free so the loop vectorizes
+    for(int i = 0; i < size; i++) {
+      double time = clock - begin[i];
+      float now = time - dur[i]*(Sint64)(time*invDur[i]);
+      t[i] = now;
+      int current = (int)(now*invSpeed[i]);
+      s[i] = current < count[i] ? current : count[i] - 1;
+    }
+
+    for(int i = 0; i < size; i++) {
+      gather(i);
+    }
+  }
+
+  void AnimationSystem::resolve(int id, SpriteRecord* record) {
+    evaluate(id);
+    record->src = srcRect[id];
+    record->dest = {
+      record->origin.x + destOffset[id].x,
+      record->origin.y + destOffset[id].y,
+      (float)srcRect[id].w,
+      (float)srcRect[id].h
+    };
+  }
+
+  void AnimationSystem::reset(int id) {
+    start[id] = clock;
+    elapsed[id] = 0;
+    step[id] = 0;
+    gather(id);
+  }
+
+  void AnimationSystem::setFrame(int id, int frame) {
+    this->frame[id] = frame;
+    srcRect[id] = sheets[id]->getFrameRect(frame);
+    destOffset[id] = sheets[id]->getFrameOffset(frame);
+    evaluated[id] = tick;
+  }
+
+  int AnimationSystem::getFrame(int id) {
+    evaluate(id);
+    return frame[id];
+  }
+
+  SpriteSheet* AnimationSystem::getSpriteSheet(int id) {
+    return sheets[id];
+  }
+
+  SDL_Rect* AnimationSystem::getSrcRect(int id) {
+    evaluate(id);
+    return &srcRect[id];
+  }
+
+  SDL_Rect* AnimationSystem::getLastSrcRect(int id) {
+    return &srcRect[id];
+  }
+
+  SDL_Point* AnimationSystem::getDestOffset(int id) {
+    return &destOffset[id];
+  }
+
+  int AnimationSystem::getSize() {
+    return start.size();
+  }
+}
@@ -35,31 +35,147 @@ namespace blackhole::graphics {
   AnimatorController::AnimatorController(animation_holder* animations, long int array_length){
 	this->array_length = array_length;
 	this->animations = animations;
+	for(int i = 0; i < array_length; i++) {
+	  states.insert({animationId(animations[i].name), i});
+	}
+	transitions.resize(array_length);
+	this->currentState = 0;
 	this->currentAnimation = &animations[0].animation;
 	this->currentAnimationName = animations[0].name;
 	this->destRect.w = currentAnimation->getDestRect()->w;
 	this->destRect.h = currentAnimation->getDestRect()->h;
+
+	this->system = currentAnimation->getAnimationSystem();
+	system->addController(this);
+
+	this->x = 0;
+	this->y = 0;
+	setCustomDraw(false);
+	record.hasSrc = true;
+	updateRecord();
+  }
+
+  AnimatorController::AnimatorController(const AnimatorController& controller) : ImageBase(controller) {
+	x = controller.x;
+	y = controller.y;
+	array_length = controller.array_length;
+	animations = controller.animations;
+	currentAnimation = controller.currentAnimation;
+	currentAnimationName = controller.currentAnimationName;
+	currentState = controller.currentState;
+	states = controller.states;
+	parameterSlots = controller.parameterSlots;
+	parameters = controller.parameters;
+	transitions = controller.transitions;
+	anyTransitions = controller.anyTransitions;
+	system = controller.system;
+	system->addController(this);
   }
 
   AnimatorController::~AnimatorController() {
+	system->removeController(this);
   }
 
   void AnimatorController::setAnimation(const char* animation) {
-	if(animation == currentAnimationName) {
+	setAnimation(animationId(animation));
+  }
+
+  void AnimatorController::setAnimation(AnimationId animation) {
+	auto state = states.find(animation);
+	if(state != states.end()) {
+	  setState(state->second);
+	}
+  }
+
+  void AnimatorController::setState(int state) {
+	if(state == currentState) {
 	  return;
 	}
-	for(int i = 0; i < array_length; i++) {
-	  if(animations[i].name == animation) {
-		currentAnimation = &animations[i].animation;
-		currentAnimationName = animations[i].name;
-		destRect.w = currentAnimation->getDestRect()->w;
-		destRect.h = currentAnimation->getDestRect()->h;
+	currentState = state;
+	currentAnimation = &animations[state].animation;
+	currentAnimationName = animations[state].name;
+	destRect.w = currentAnimation->getDestRect()->w;
+	destRect.h = currentAnimation->getDestRect()->h;
+
+	currentAnimation->resetAnimation();
+	updateRecord();
+  }
+
+  int AnimatorController::getParameterSlot(AnimationId parameter) {
+	auto slot = parameterSlots.find(parameter);
+	if(slot != parameterSlots.end()) {
+	  return slot->second;
+	}
+	parameters.push_back(0);
+	parameterSlots.insert({parameter, (int)parameters.size() - 1});
+	return parameters.size() - 1;
+  }
+
+  void AnimatorController::setParameter(AnimationId parameter, float value) {
+	parameters[getParameterSlot(parameter)] = value;
+  }
+
+  float AnimatorController::getParameter(AnimationId parameter) {
+	auto slot = parameterSlots.find(parameter);
+	return slot != parameterSlots.end() ? parameters[slot->second] : 0;
+  }
+
+  void AnimatorController::addTransition(AnimationId from, AnimationId to, AnimationId parameter, AnimatorCondition condition, float value) {
+	auto toState = states.find(to);
+	if(toState == states.end()) {
+	  printf("Animation %u not found\n", to);
+	  return;
+	}
+	AnimatorTransition transition = {
+	  toState->second,
+	  getParameterSlot(parameter),
+	  condition,
+	  value
+	};
+
+	if(from == ANY_ANIMATION) {
+	  anyTransitions.push_back(transition);
+	  return;
+	}
+	auto fromState = states.find(from);
+	if(fromState == states.end()) {
+	  printf("Animation %u not found\n", from);
+	  return;
+	}
+	transitions[fromState->second].push_back(transition);
+  }
 
-		currentAnimation->resetAnimation();
+  bool AnimatorController::check(const AnimatorTransition& transition) {
+	float parameter = parameters[transition.parameter];
+	switch(transition.condition) {
+	case ANIMATOR_GREATER:
+	  return parameter > transition.value;
+	case ANIMATOR_LESS:
+	  return parameter < transition.value;
+	case ANIMATOR_EQUAL:
+	  return parameter == transition.value;
+	case ANIMATOR_NOT_EQUAL:
+	  return parameter != transition.value;
+	}
+	return false;
+  }
+
+  void AnimatorController::evaluate() {
+	for(const AnimatorTransition& transition : transitions[currentState]) {
+	  if(check(transition)) {
+		setState(transition.to);
+		return;
+	  }
+	}
+	for(const AnimatorTransition& transition : anyTransitions) {
+	  if(transition.to != currentState && check(transition)) {
+		setState(transition.to);
+		return;
 	  }
 	}
   }
 
+
   Animation* AnimatorController::getAnimation() {
 	return currentAnimation;
   }
@@ -69,11 +185,21 @@ namespace blackhole::graphics {
   }
 
   void AnimatorController::setX(float x) {
-    this->x = x;
+	this->x = x;
+	updateRecord();
   }
 
   void AnimatorController::setY(float y) {
 	this->y = y;
+	updateRecord();
+  }
+
+  void AnimatorController::updateRecord() {
+	record.texture = currentAnimation->getTexture();
+	record.animation = system;
+	record.animationSlot = currentAnimation->getSlot();
+	record.origin = {x, y};
+	record.dest = {x, y, (float)destRect.w, (float)destRect.h};
   }
 
   float AnimatorController::getX() {
@@ -84,10 +210,6 @@ namespace blackhole::graphics {
 	return y;
   }
 
-  void AnimatorController::addTime(float time) {
-	currentAnimation->addTime(time);
-  }
-
   SDL_Texture* AnimatorController::getTexture() {
 	return currentAnimation->getTexture();
   }
@@ -29,6 +29,7 @@
  */
 
 #include "graphics/camera.h"
+#include <atomic>
 
 namespace blackhole::graphics {
 
@@ -36,33 +37,52 @@ namespace blackhole::graphics {
   
   Camera::Camera(SDL_Renderer* renderer, int w, int h, float x, float y) {
     this->renderer = renderer;
-    this->texture = SDL_CreateTexture(renderer,
-				      SDL_PIXELFORMAT_RGBX8888,
-				      SDL_TEXTUREACCESS_TARGET,
-				      w,
-				      h);
-    this->x = x;
-    this->y = y;
+    this->x = 0;
+    this->y = 0;
 
-    destRect = {(int)x, (int)y, w, h};
+    destRect = {(int)round(x), (int)round(y), w, h};
     viewport = {0, 0, w, h};
+    // Most cameras only view the world, so the cache is made by the
+    // first getTexture()
+    cache = NULL;
+    static std::atomic<Uint32> nextId{1};
+    id = nextId++;
   }
 
   Camera::~Camera() {
-    SDL_DestroyTexture(texture);
+    delete cache;
   }
 
   void Camera::setX(float x) {
     this->x = x;
+    updateViewport();
   }
 
   void Camera::setY(float y) {
     this->y = y;
+    updateViewport();
+  }
+
+  float Camera::getX() {
+    return x;
+  }
+
+  float Camera::getY() {
+    return y;
+  }
+
+  void Camera::updateViewport() {
+    // A view between pixels touches one more column and row of the world
+    viewport.x = floorf(x);
+    viewport.y = floorf(y);
+    viewport.w = destRect.w + (x != viewport.x ? 1 : 0);
+    viewport.h = destRect.h + (y != viewport.y ? 1 : 0);
   }
 
   void Camera::addImage(ImageBase* image) {
     ImageHolder imageHolder = {
-      image
+      image,
+      image->getRecord()
     };
     renderQueue.push_back(imageHolder);
     renderQueue.sort(compare_position);
@@ -79,25 +99,37 @@ namespace blackhole::graphics {
   }
   
   SDL_Texture* Camera::getTexture() {
-    SDL_SetRenderTarget(renderer, texture);
-    SDL_RenderClear(renderer);
-
+    if(cache == NULL) {
+      cache = new RenderCache(renderer, destRect.w, destRect.h);
+    }
+    cache->begin();
     for(auto image = renderQueue.begin(); image != renderQueue.end(); ++image) {
-      SDL_RenderCopyEx(renderer, image->image->getTexture(), image->image->getSrcRect(),image->image->getDestRect(), 0, NULL, image->image->getRendererFlip());
+      cache->add(image->record);
     }
-    
-    
-    SDL_SetRenderTarget(renderer, NULL);
-    return texture;
+    cache->end();
+    return cache->getTexture();
+  }
+
+  Uint32 Camera::getVersion() {
+    return cache != NULL ? cache->getVersion() : 0;
   }
 
-  SDL_Texture* Camera::getCamTexture() {
-    return texture;
+  Uint32 Camera::getId() {
+    return id;
   }
 
-  void Camera::addTime(float time) {
+  void Camera::recordImages(RenderCommandBuffer* commands) {
+    // The cache draws in the order of recording, so the layer is unused
     for(auto image = renderQueue.begin(); image != renderQueue.end(); ++image) {
-      image->image->addTime(time);
+      commands->add(image->record, 0);
     }
   }
+
+  void Camera::recordDraw(RenderCommandBuffer* commands, int layer) {
+    static std::atomic<bool> warned(false);
+    if(!warned.exchange(true)) {
+      printf("A Camera inside another Camera is not drawn\n");
+    }
+  }
+
 }
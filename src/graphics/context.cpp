@@ -0,0 +1,76 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file context.cpp
+ *
+ * A blackhole library class sharing the SDL subsystems between instances
+ */
+
+#include "graphics/context.h"
+#include <SDL2/SDL_ttf.h>
+#include <mutex>
+#include <stdio.h>
+
+namespace blackhole::graphics {
+
+  // SDL_InitSubSystem() counts references per subsystem but is not
+  // thread safe, and SDL_Quit() ignores the counts
+  static std::mutex contextMutex;
+  static int contextCount = 0;
+
+  Context::Context(Uint32 flags) {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    this->flags = flags;
+    valid = SDL_InitSubSystem(flags) == 0;
+    if(!valid) {
+      printf("Failed to Initialize SDL2: %s\n", SDL_GetError());
+      return;
+    }
+    if(contextCount++ == 0) {
+      TTF_Init();
+    }
+  }
+
+  Context::~Context() {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    if(!valid) {
+      return;
+    }
+    SDL_QuitSubSystem(flags);
+    if(--contextCount == 0) {
+      TTF_Quit();
+      SDL_Quit();
+    }
+  }
+
+  bool Context::isValid() {
+    return valid;
+  }
+
+  int Context::getCount() {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    return contextCount;
+  }
+}
@@ -0,0 +1,309 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file flight_recorder.cpp
+ *
+ * A blackhole library class for capturing the timings around slow frames
+ */
+
+#include "graphics/flight_recorder.h"
+#include "jobs/thread_pool.h"
+#include <memory>
+#include <stdio.h>
+#include <string.h>
+
+namespace blackhole::graphics {
+
+  // Write a string as the contents of a JSON string
+  static void writeEscaped(FILE* out, const char* string) {
+    for(; *string != '\0'; string++) {
+      if(*string == '"' || *string == '\\') {
+        fputc('\\', out);
+      }
+      fputc((Uint8)*string < ' ' ? ' ' : *string, out);
+    }
+  }
+
+  // What the calling thread works on, set with setThreadFrame()
+  static thread_local Uint32 threadInstance = 0;
+  static thread_local Uint64 threadFrame = 0;
+
+  FlightRecorder::FlightRecorder(int capacity) {
+    // Recorders are told apart by id rather than address, which a new
+    // recorder may reuse
+    static std::atomic<Uint32> nextId{1};
+    id = nextId++;
+    enabled = true;
+    budget = 0;
+    seconds = 3;
+    prefix = "hitch_";
+    captures = 0;
+    writing = 0;
+    setCapacity(capacity);
+    // Made first so the pool outlives the default recorder
+    jobs::ThreadPool::getDefault();
+  }
+
+  FlightRecorder::~FlightRecorder() {
+    wait();
+  }
+
+  FlightRecorder* FlightRecorder::getDefault() {
+    static FlightRecorder recorder;
+    return &recorder;
+  }
+
+  Uint32 FlightRecorder::getThreadId() {
+    // Small ids read better in a trace than native ones
+    static std::atomic<Uint32> nextId{1};
+    thread_local Uint32 id = nextId++;
+    return id;
+  }
+
+  void FlightRecorder::setEnabled(bool enabled) {
+    this->enabled = enabled;
+  }
+
+  bool FlightRecorder::isEnabled() {
+    return enabled;
+  }
+
+  void FlightRecorder::setCapacity(int capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(capacity < 1) {
+      capacity = 1;
+    }
+    this->capacity = capacity;
+    for(auto& buffer : buffers) {
+      std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+      buffer->events.assign(capacity, Event());
+      buffer->next = 0;
+      buffer->count = 0;
+    }
+  }
+
+  void FlightRecorder::setThreadFrame(Uint32 instance, Uint64 frame) {
+    threadInstance = instance;
+    threadFrame = frame;
+  }
+
+  FlightRecorder::ThreadBuffer* FlightRecorder::getBuffer() {
+    // Threads keep the buffers they were given, which go back to their
+    // recorder when the thread exits. They are shared so either may go
+    // first
+    struct HeldBuffers {
+      std::vector<std::pair<Uint32, std::shared_ptr<ThreadBuffer>>> held;
+      ~HeldBuffers() {
+        for(auto& buffer : held) {
+          buffer.second->used = false;
+        }
+      }
+    };
+    static thread_local HeldBuffers local;
+    for(auto& buffer : local.held) {
+      if(buffer.first == id) {
+        return buffer.second.get();
+      }
+    }
+
+    std::shared_ptr<ThreadBuffer> buffer;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      // The buffer of a thread that exited keeps its events until the
+      // new thread writes over them
+      for(auto& unused : buffers) {
+        bool expected = false;
+        if(unused->used.compare_exchange_strong(expected, true)) {
+          buffer = unused;
+          break;
+        }
+      }
+      if(buffer == NULL) {
+        buffer.reset(new ThreadBuffer());
+        buffer->events.assign(capacity, Event());
+        buffer->next = 0;
+        buffer->count = 0;
+        buffer->used = true;
+        buffers.push_back(buffer);
+      }
+    }
+    local.held.push_back({id, buffer});
+    return buffer.get();
+  }
+
+  Uint64 FlightRecorder::record(const char* name, Uint64 start, const char* detail) {
+    Uint64 end = SDL_GetPerformanceCounter();
+    if(!enabled) {
+      return end;
+    }
+    Uint32 thread = getThreadId();
+    ThreadBuffer* buffer = getBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    std::vector<Event>& events = buffer->events;
+    Event& event = events[buffer->next];
+    event.name = name;
+    event.detail[0] = '\0';
+    if(detail != NULL) {
+      // The end of a path names the file
+      size_t length = strlen(detail);
+      if(length >= sizeof(event.detail)) {
+        detail += length - (sizeof(event.detail) - 1);
+      }
+      strcpy(event.detail, detail);
+    }
+    event.start = start;
+    event.end = end;
+    event.frame = threadFrame;
+    event.thread = thread;
+    event.instance = threadInstance;
+    buffer->next = (buffer->next + 1) % events.size();
+    if(buffer->count < events.size()) {
+      buffer->count++;
+    }
+    return end;
+  }
+
+  void FlightRecorder::endFrame(Uint64 frame, float frameTime) {
+    if(!enabled) {
+      return;
+    }
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 length = frameTime*frequency/1000.0f;
+    record("frame", length < now ? now - length : 0);
+
+    Uint32 instance = threadInstance;
+    std::string file;
+    float captureSeconds;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if(budget <= 0 || frameTime <= budget) {
+        return;
+      }
+      auto last = lastCaptures.find(instance);
+      if(last != lastCaptures.end() && now - last->second < seconds*frequency) {
+        return;
+      }
+      lastCaptures[instance] = now;
+      captures++;
+      file = prefix + (instance != 0 ? std::to_string(instance) + "_" : "") + std::to_string(frame) + ".json";
+      captureSeconds = seconds;
+    }
+
+    // Only the copy is made here, writing would be another hitch
+    std::shared_ptr<std::vector<Event>> capture(new std::vector<Event>());
+    copy(capture.get(), captureSeconds, false, instance);
+    jobs::ThreadPool::getDefault()->submit([file, capture]() {
+      write(file.c_str(), *capture);
+    }, &writing);
+  }
+
+  void FlightRecorder::wait() {
+    jobs::ThreadPool::getDefault()->wait(&writing);
+  }
+
+  void FlightRecorder::setCapture(float budget, float seconds, const char* prefix) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->budget = budget;
+    this->seconds = seconds;
+    this->prefix = prefix;
+  }
+
+  void FlightRecorder::copy(std::vector<Event>* out, float seconds, bool all, Uint32 instance) {
+    Uint64 since = 0;
+    Uint64 window = seconds*SDL_GetPerformanceFrequency();
+    Uint64 now = SDL_GetPerformanceCounter();
+    if(seconds > 0 && window < now) {
+      since = now - window;
+    }
+    std::vector<std::shared_ptr<ThreadBuffer>> copied;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      copied = buffers;
+    }
+    // Copied under the locks and written after so other threads are not
+    // held up by the disk
+    for(auto& buffer : copied) {
+      std::lock_guard<std::mutex> lock(buffer->mutex);
+      std::vector<Event>& events = buffer->events;
+      size_t first = (buffer->next + events.size() - buffer->count) % events.size();
+      for(size_t i = 0; i < buffer->count; i++) {
+        const Event& event = events[(first + i) % events.size()];
+        if(event.end >= since && (all || event.instance == 0 || event.instance == instance)) {
+          out->push_back(event);
+        }
+      }
+    }
+  }
+
+  bool FlightRecorder::write(const char* file, const std::vector<Event>& events) {
+    FILE* out = fopen(file, "w");
+    if(out == NULL) {
+      printf("Failed to open %s for writing\n", file);
+      return false;
+    }
+    double frequency = SDL_GetPerformanceFrequency();
+    fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for(size_t i = 0; i < events.size(); i++) {
+      const Event& event = events[i];
+      fprintf(out, "%s\n{\"name\":\"", i == 0 ? "" : ",");
+      writeEscaped(out, event.name);
+      fprintf(out, "\",\"cat\":\"blackhole\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+              "\"args\":{\"frame\":%llu,\"detail\":\"", event.instance, event.thread,
+              event.start*1000000.0/frequency, (event.end - event.start)*1000000.0/frequency,
+              (unsigned long long)event.frame);
+      writeEscaped(out, event.detail);
+      fprintf(out, "\"}}");
+    }
+    fprintf(out, "\n]}\n");
+    bool ok = ferror(out) == 0;
+    fclose(out);
+    if(!ok) {
+      printf("Failed to write %s\n", file);
+    }
+    return ok;
+  }
+
+  bool FlightRecorder::dump(const char* file, float seconds) {
+    std::vector<Event> events;
+    copy(&events, seconds, true, 0);
+    return write(file, events);
+  }
+
+  int FlightRecorder::getCaptureCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return captures;
+  }
+
+  FlightScope::FlightScope(const char* name, const char* detail) {
+    this->name = name;
+    this->detail = detail;
+    this->start = SDL_GetPerformanceCounter();
+  }
+
+  FlightScope::~FlightScope() {
+    FlightRecorder::getDefault()->record(name, start, detail);
+  }
+}
@@ -0,0 +1,171 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file frame_pipeline.cpp
+ *
+ * A blackhole library class for handing frames from the simulation to the renderer
+ */
+
+#include "graphics/frame_pipeline.h"
+#include "graphics/texture.h"
+#include <chrono>
+
+namespace blackhole::graphics {
+
+  FramePipeline::FramePipeline(int maxFramesInFlight) {
+    writing = NULL;
+    reading = NULL;
+    nextIndex = 0;
+    readIndex = 0;
+    closed = false;
+    latency = 0;
+    this->maxFramesInFlight = 0;
+    setMaxFramesInFlight(maxFramesInFlight);
+  }
+
+  Frame* FramePipeline::beginWrite() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this]() {
+      return closed || ((int)queued.size() < maxFramesInFlight && !free.empty());
+    });
+    if(closed) {
+      return NULL;
+    }
+    writing = free.front();
+    free.pop_front();
+    writing->index = nextIndex++;
+    writing->start = SDL_GetPerformanceCounter();
+    writing->stats = FrameStats();
+    writing->stats.index = writing->index;
+    return writing;
+  }
+
+  void FramePipeline::endWrite() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if(writing == NULL) {
+        return;
+      }
+      queued.push_back(writing);
+      writing = NULL;
+    }
+    changed.notify_all();
+  }
+
+  Frame* FramePipeline::beginRead(int timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if(!changed.wait_for(lock, std::chrono::milliseconds(timeout), [this]() { return !queued.empty(); })) {
+      return NULL;
+    }
+    reading = queued.front();
+    queued.pop_front();
+    return reading;
+  }
+
+  void FramePipeline::endRead() {
+    std::vector<SDL_Texture*> ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if(reading == NULL) {
+        return;
+      }
+      Uint64 elapsed = SDL_GetPerformanceCounter() - reading->start;
+      latency = elapsed*1000.0f/SDL_GetPerformanceFrequency();
+      // Frames are drawn in order, so every frame before this one is done
+      readIndex = reading->index + 1;
+      free.push_back(reading);
+      reading = NULL;
+      for(size_t i = 0; i < released.size();) {
+        if(released[i].first <= readIndex) {
+          ready.push_back(released[i].second);
+          released[i] = released.back();
+          released.pop_back();
+        }
+        else {
+          i++;
+        }
+      }
+    }
+    changed.notify_all();
+    for(SDL_Texture* texture : ready) {
+      destroyTexture(texture);
+    }
+  }
+
+  void FramePipeline::close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      closed = true;
+    }
+    changed.notify_all();
+  }
+
+  void FramePipeline::releaseTexture(SDL_Texture* texture) {
+    std::lock_guard<std::mutex> lock(mutex);
+    released.push_back({nextIndex, texture});
+  }
+
+  void FramePipeline::destroyReleased() {
+    std::vector<std::pair<Uint64, SDL_Texture*>> all;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      all.swap(released);
+    }
+    for(auto& texture : all) {
+      destroyTexture(texture.second);
+    }
+  }
+
+  void FramePipeline::setMaxFramesInFlight(int maxFramesInFlight) {
+    if(maxFramesInFlight < 1) {
+      maxFramesInFlight = 1;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      this->maxFramesInFlight = maxFramesInFlight;
+      // One frame is being written and one drawn besides those waiting.
+      // Frames are only ever added so none in use is freed
+      while((int)frames.size() < maxFramesInFlight + 2) {
+        frames.push_back(std::unique_ptr<Frame>(new Frame()));
+        free.push_back(frames.back().get());
+      }
+    }
+    changed.notify_all();
+  }
+
+  int FramePipeline::getMaxFramesInFlight() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxFramesInFlight;
+  }
+
+  int FramePipeline::getFramesInFlight() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queued.size();
+  }
+
+  float FramePipeline::getLatency() {
+    return latency;
+  }
+}
@@ -0,0 +1,117 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file frame_stats.cpp
+ *
+ * A blackhole library class for keeping the render statistics of recent frames
+ */
+
+#include "graphics/frame_stats.h"
+#include <algorithm>
+
+namespace blackhole::graphics {
+
+  FrameStatsRing::FrameStatsRing(int capacity) {
+    next = 0;
+    count = 0;
+    setCapacity(capacity);
+  }
+
+  void FrameStatsRing::push(const FrameStats& stats) {
+    std::lock_guard<std::mutex> lock(mutex);
+    frames[next] = stats;
+    next = (next + 1) % frames.size();
+    if(count < frames.size()) {
+      count++;
+    }
+  }
+
+  void FrameStatsRing::setCapacity(int capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(capacity < 1) {
+      capacity = 1;
+    }
+    frames.assign(capacity, FrameStats());
+    scratch.reserve(capacity);
+    next = 0;
+    count = 0;
+  }
+
+  int FrameStatsRing::getCapacity() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return frames.size();
+  }
+
+  int FrameStatsRing::getCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+  }
+
+  bool FrameStatsRing::getLatest(FrameStats* stats) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(count == 0) {
+      return false;
+    }
+    *stats = frames[(next + frames.size() - 1) % frames.size()];
+    return true;
+  }
+
+  void FrameStatsRing::copy(std::vector<FrameStats>* stats) {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats->clear();
+    size_t first = (next + frames.size() - count) % frames.size();
+    for(size_t i = 0; i < count; i++) {
+      stats->push_back(frames[(first + i) % frames.size()]);
+    }
+  }
+
+  float FrameStatsRing::getFrameTimePercentile(float percentile) {
+    return this->percentile(&FrameStats::frameTime, percentile);
+  }
+
+  float FrameStatsRing::getUpdateTimePercentile(float percentile) {
+    return this->percentile(&FrameStats::updateTime, percentile);
+  }
+
+  float FrameStatsRing::getRenderTimePercentile(float percentile) {
+    return this->percentile(&FrameStats::renderTime, percentile);
+  }
+
+  float FrameStatsRing::percentile(float FrameStats::*field, float percentile) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(count == 0) {
+      return 0;
+    }
+    // Nearest rank, only partially sorting the copy
+    scratch.clear();
+    for(size_t i = 0; i < count; i++) {
+      scratch.push_back(frames[i].*field);
+    }
+    percentile = std::min(std::max(percentile, 0.0f), 100.0f);
+    size_t rank = (size_t)(percentile/100.0f*(count - 1) + 0.5f);
+    std::nth_element(scratch.begin(), scratch.begin() + rank, scratch.end());
+    return scratch[rank];
+  }
+}
@@ -36,8 +36,9 @@ namespace blackhole::graphics {
 	
 	init(file, renderer);
 
-	this->x = x;
-	this->y = y;
+	setCustomDraw(false);
+	setX(x);
+	setY(y);
   }
 
   
@@ -48,10 +49,12 @@ namespace blackhole::graphics {
   
   void Image::setX(float x) {
 	this->x = x;
+	record.dest.x = x;
   }
 
   void Image::setY(float y) {
 	this->y = y;
+	record.dest.y = y;
   }
   
   float Image::getX() {
@@ -29,15 +29,46 @@
  */
 
 #include "graphics/imageBase.h"
+#include "graphics/texture.h"
+#include "graphics/render_command_buffer.h"
+#include "graphics/flight_recorder.h"
 #include <SDL2/SDL_image.h>
 
 namespace blackhole::graphics {
+  ImageBase::ImageBase() {
+    texture = NULL;
+    destRect = {0, 0, 0, 0};
+    // Until a subclass keeps the record up to date it is drawn through
+    // the virtual functions
+    record = {NULL, {0, 0, 0, 0}, {0, 0, 0, 0}, SDL_FLIP_NONE, false, {0, 0}, NULL, 0, NULL, {0, 0, 0, 0}, this};
+  }
+
+  ImageBase::ImageBase(const ImageBase& image) {
+    *this = image;
+  }
+
+  ImageBase& ImageBase::operator=(const ImageBase& image) {
+    rendererFlip = image.rendererFlip;
+    layer = image.layer;
+    destRect = image.destRect;
+    texture = image.texture;
+    record = image.record;
+    if(record.custom == &image) {
+      record.custom = this;
+    }
+    return *this;
+  }
+
+  ImageBase::~ImageBase() {
+  }
+
   void ImageBase::init(const char* file, SDL_Renderer* renderer) {
 
     if(file == NULL) {
       
       return;
     }
+    FlightScope scope("load image", file);
     
     SDL_Surface* surface;
     SDL_RWops* src = SDL_RWFromFile(file, "rb");
@@ -100,14 +131,17 @@ namespace blackhole::graphics {
       printf("Unable to Load Image\n");
     }
 
-    this->texture = SDL_CreateTextureFromSurface(renderer, surface);
+    this->texture = createTextureFromSurface(renderer, surface);
     SDL_FreeSurface(surface);
 
     if(this->texture == NULL) {
       printf("Unable to Create Texture\n");
     }
 
-    SDL_QueryTexture(this->texture, NULL, NULL, &destRect.w, &destRect.h);
+    queryTexture(this->texture, NULL, NULL, &destRect.w, &destRect.h);
+    record.texture = texture;
+    record.dest.w = destRect.w;
+    record.dest.h = destRect.h;
   }
 
   void ImageBase::addTime(float time) {
@@ -120,7 +154,7 @@ namespace blackhole::graphics {
     else if(!flipped && (rendererFlip | SDL_FLIP_HORIZONTAL) == rendererFlip) {
       rendererFlip = static_cast<SDL_RendererFlip>(rendererFlip ^ SDL_FLIP_HORIZONTAL);
     }
-	
+    record.flip = rendererFlip;
   }
 
   void ImageBase::setFlipY(bool flipped) {
@@ -130,6 +164,7 @@ namespace blackhole::graphics {
     else if(!flipped && (rendererFlip | SDL_FLIP_VERTICAL) == rendererFlip) {
       rendererFlip = static_cast<SDL_RendererFlip>(rendererFlip ^ SDL_FLIP_VERTICAL);;
     }
+    record.flip = rendererFlip;
   }
 
   bool ImageBase::isFlippedX() {
@@ -162,9 +197,12 @@ namespace blackhole::graphics {
   }
   
   void ImageBase::setTexture(SDL_Texture* tex) {
-    SDL_DestroyTexture(texture);
+    releaseTexture(texture);
     texture = tex;
-    SDL_QueryTexture(this->texture, NULL, NULL, &destRect.w, &destRect.h);
+    queryTexture(this->texture, NULL, NULL, &destRect.w, &destRect.h);
+    record.texture = texture;
+    record.dest.w = destRect.w;
+    record.dest.h = destRect.h;
   }
   
   SDL_Texture* ImageBase::getTexture() {
@@ -172,6 +210,34 @@ namespace blackhole::graphics {
   }
 
 
+  void ImageBase::draw(SDL_Renderer* renderer) {
+    SDL_Rect* srcRect = getSrcRect();
+    SDL_RenderCopyEx(renderer, getTexture(), srcRect, getDestRect(), 0, NULL, getRendererFlip());
+  }
+
+  void ImageBase::setCustomDraw(bool custom) {
+    record.custom = custom ? this : NULL;
+  }
+
+  void ImageBase::recordDraw(RenderCommandBuffer* commands, int layer) {
+    if(record.custom == NULL) {
+      commands->add(&record, layer);
+      return;
+    }
+    // Worked out now so the render thread never calls back into the image
+    SDL_Rect* destRect = getDestRect();
+    SDL_FRect dest = {(float)destRect->x, (float)destRect->y, (float)destRect->w, (float)destRect->h};
+    commands->addTexture(getTexture(), getSrcRect(), &dest, layer, getRendererFlip());
+  }
+
+  void ImageBase::setTransform(TransformNode* transform) {
+    record.transform = transform;
+  }
+
+  TransformNode* ImageBase::getTransform() {
+    return record.transform;
+  }
+
   void ImageBase::setLayer(int layer) {
     this->layer = layer;
   }
@@ -0,0 +1,289 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file particle_emitter.cpp
+ *
+ * A blackhole library class for simulating and drawing many particles
+ */
+
+#include "graphics/particle_emitter.h"
+#include "graphics/texture.h"
+#include "graphics/render_command_buffer.h"
+#include "jobs/thread_pool.h"
+#include <math.h>
+
+namespace blackhole::graphics {
+
+  ParticleEmitter::ParticleEmitter(SpriteSheet* sheet, int capacity, float x, float y) {
+    this->sheet = sheet;
+    this->capacity = capacity;
+    this->x = x;
+    this->y = y;
+    this->texture = NULL;
+
+    textureWidth = 1;
+    textureHeight = 1;
+    width = 4;
+    height = 4;
+    if(sheet != NULL) {
+      queryTexture(sheet->getTexture(), NULL, NULL, &textureWidth, &textureHeight);
+      width = sheet->getFrameRect(0).w;
+      height = sheet->getFrameRect(0).h;
+    }
+
+    posX.resize(capacity);
+    posY.resize(capacity);
+    velX.resize(capacity);
+    velY.resize(capacity);
+    age.resize(capacity);
+    inverseLife.resize(capacity);
+    vertices.resize(capacity*4);
+
+    // Every particle is a quad of two triangles that never changes order
+    indices.resize(capacity*6);
+    for(int i = 0; i < capacity; i++) {
+      int* quad = &indices[i*6];
+      quad[0] = i*4;
+      quad[1] = i*4 + 1;
+      quad[2] = i*4 + 2;
+      quad[3] = i*4;
+      quad[4] = i*4 + 2;
+      quad[5] = i*4 + 3;
+    }
+
+    destRect = {(int)x, (int)y, 0, 0};
+  }
+
+  ParticleEmitter::~ParticleEmitter() {
+  }
+
+  float ParticleEmitter::random() {
+    // xorshift32 keeps emitters deterministic and cheap
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return (seed >> 8)*(1.0f/16777216.0f);
+  }
+
+  void ParticleEmitter::emit(int amount) {
+    if(amount > capacity - count) {
+      amount = capacity - count;
+    }
+    for(int i = count; i < count + amount; i++) {
+      float direction = angle + (random() - 0.5f)*spread;
+      float speed = minSpeed + (maxSpeed - minSpeed)*random();
+      float life = minLife + (maxLife - minLife)*random();
+      posX[i] = x;
+      posY[i] = y;
+      velX[i] = cosf(direction)*speed;
+      velY[i] = sinf(direction)*speed;
+      age[i] = 0;
+      inverseLife[i] = life > 0 ? 1/life : 1e30f;
+    }
+    count += amount;
+  }
+
+  void ParticleEmitter::integrate(int begin, int end, float time) {
+    float* px = posX.data();
+    float* py = posY.data();
+    float* vx = velX.data();
+    float* vy = velY.data();
+    float* a = age.data();
+    float ax = accelerationX*time;
+    float ay = accelerationY*time;
+    for(int i = begin; i < end; i++) {
+      vx[i] += ax;
+      vy[i] += ay;
+      px[i] += vx[i]*time;
+      py[i] += vy[i]*time;
+      a[i] += time;
+    }
+  }
+
+  void ParticleEmitter::build(int begin, int end) {
+    const float* px = posX.data();
+    const float* py = posY.data();
+    const float* a = age.data();
+    const float* invLife = inverseLife.data();
+    float halfWidth = width/2;
+    float halfHeight = height/2;
+    float invWidth = 1.0f/textureWidth;
+    float invHeight = 1.0f/textureHeight;
+    int frames = sheet != NULL ? sheet->getFrameCount() : 1;
+    const SDL_Rect* frameTable = sheet != NULL ? sheet->getFrameTable() : NULL;
+
+    for(int i = begin; i < end; i++) {
+      float t = a[i]*invLife[i];
+      t = t < 1 ? t : 1;
+      SDL_Color color = {
+        (Uint8)(startColor.r + (endColor.r - startColor.r)*t),
+        (Uint8)(startColor.g + (endColor.g - startColor.g)*t),
+        (Uint8)(startColor.b + (endColor.b - startColor.b)*t),
+        (Uint8)(startColor.a + (endColor.a - startColor.a)*t)
+      };
+      float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+      if(frameTable != NULL) {
+        int frame = (int)(t*frames);
+        const SDL_Rect& rect = frameTable[frame < frames ? frame : frames - 1];
+        u0 = rect.x*invWidth;
+        v0 = rect.y*invHeight;
+        u1 = (rect.x + rect.w)*invWidth;
+        v1 = (rect.y + rect.h)*invHeight;
+      }
+
+      SDL_Vertex* quad = &vertices[i*4];
+      quad[0] = {{px[i] - halfWidth, py[i] - halfHeight}, color, {u0, v0}};
+      quad[1] = {{px[i] + halfWidth, py[i] - halfHeight}, color, {u1, v0}};
+      quad[2] = {{px[i] + halfWidth, py[i] + halfHeight}, color, {u1, v1}};
+      quad[3] = {{px[i] - halfWidth, py[i] + halfHeight}, color, {u0, v1}};
+    }
+  }
+
+  void ParticleEmitter::parallel(const std::function<void(int, int)>& kernel) {
+    // Small counts are not worth the cost of a task
+    int grain = (count + threads - 1)/threads;
+    jobs::ThreadPool::getDefault()->parallelFor(count, grain > 4096 ? grain : 4096, kernel);
+  }
+
+  void ParticleEmitter::update(float time) {
+    emitted += rate*time;
+    int amount = (int)emitted;
+    emitted -= amount;
+    emit(amount);
+
+    parallel([this, time](int begin, int end) { integrate(begin, end, time); });
+
+    // Dead particles are replaced by the last particle so the arrays stay
+    // packed
+    for(int i = 0; i < count;) {
+      if(age[i]*inverseLife[i] < 1) {
+        i++;
+        continue;
+      }
+      count--;
+      posX[i] = posX[count];
+      posY[i] = posY[count];
+      velX[i] = velX[count];
+      velY[i] = velY[count];
+      age[i] = age[count];
+      inverseLife[i] = inverseLife[count];
+    }
+
+    parallel([this](int begin, int end) { build(begin, end); });
+
+    float minX = x, minY = y, maxX = x, maxY = y;
+    for(int i = 0; i < count; i++) {
+      minX = posX[i] < minX ? posX[i] : minX;
+      minY = posY[i] < minY ? posY[i] : minY;
+      maxX = posX[i] > maxX ? posX[i] : maxX;
+      maxY = posY[i] > maxY ? posY[i] : maxY;
+    }
+    destRect = {
+      (int)floorf(minX - width/2),
+      (int)floorf(minY - height/2),
+      (int)ceilf(maxX - minX + width) + 1,
+      (int)ceilf(maxY - minY + height) + 1
+    };
+  }
+
+  void ParticleEmitter::setRate(float rate) {
+    this->rate = rate;
+  }
+
+  void ParticleEmitter::setLifetime(float min, float max) {
+    minLife = min;
+    maxLife = max;
+  }
+
+  void ParticleEmitter::setVelocity(float min, float max, float angle, float spread) {
+    minSpeed = min;
+    maxSpeed = max;
+    this->angle = angle;
+    this->spread = spread;
+  }
+
+  void ParticleEmitter::setAcceleration(float x, float y) {
+    accelerationX = x;
+    accelerationY = y;
+  }
+
+  void ParticleEmitter::setColor(SDL_Color start, SDL_Color end) {
+    startColor = start;
+    endColor = end;
+  }
+
+  void ParticleEmitter::setSize(float width, float height) {
+    this->width = width;
+    this->height = height;
+  }
+
+  void ParticleEmitter::setThreads(int threads) {
+    this->threads = threads > 1 ? threads : 1;
+  }
+
+  int ParticleEmitter::getCount() {
+    return count;
+  }
+
+  void ParticleEmitter::setX(float x) {
+    this->x = x;
+  }
+
+  void ParticleEmitter::setY(float y) {
+    this->y = y;
+  }
+
+  float ParticleEmitter::getX() {
+    return x;
+  }
+
+  float ParticleEmitter::getY() {
+    return y;
+  }
+
+  SDL_Texture* ParticleEmitter::getTexture() {
+    return sheet != NULL ? sheet->getTexture() : NULL;
+  }
+
+  SDL_Rect* ParticleEmitter::getDestRect() {
+    return &destRect;
+  }
+
+  void ParticleEmitter::recordDraw(RenderCommandBuffer* commands, int layer) {
+    if(count == 0) {
+      return;
+    }
+    // The buffer keeps its own copy, so update() can build the next
+    // frame while this one is drawn
+    commands->addGeometry(getTexture(), vertices.data(), count*4, indices.data(), count*6, layer);
+  }
+
+  void ParticleEmitter::draw(SDL_Renderer* renderer) {
+    if(count == 0) {
+      return;
+    }
+    SDL_RenderGeometry(renderer, getTexture(), vertices.data(), count*4, indices.data(), count*6);
+  }
+}
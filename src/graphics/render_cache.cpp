@@ -0,0 +1,297 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file render_cache.cpp
+ *
+ * A blackhole library class for keeping draws that rarely change in a texture
+ */
+
+#include "graphics/render_cache.h"
+#include "graphics/animation_system.h"
+#include "graphics/imageBase.h"
+#include "graphics/transform.h"
+#include "graphics/texture.h"
+#include <math.h>
+#include <string.h>
+
+namespace blackhole::graphics {
+
+  // Past this many separate regions one full redraw is cheaper
+  const int MAX_DIRTY_RECTS = 8;
+
+  RenderCache::RenderCache(SDL_Renderer* renderer, int w, int h) {
+    this->renderer = renderer;
+    this->width = w;
+    this->height = h;
+    this->texture = createTexture(renderer,
+                                  SDL_PIXELFORMAT_RGBA8888,
+                                  SDL_TEXTUREACCESS_TARGET,
+                                  w,
+                                  h);
+    if(texture == NULL) {
+      printf("Failed to create RenderCache texture: %s\n", SDL_GetError());
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    this->count = 0;
+    this->full = true;
+    this->version = 0;
+    this->commands = NULL;
+  }
+
+  RenderCache::~RenderCache() {
+    destroyTexture(texture);
+  }
+
+  void RenderCache::invalidate(const SDL_Rect* rect) {
+    if(full || rect->w <= 0 || rect->h <= 0) {
+      return;
+    }
+    // Grow an overlapping region rather than adding another one
+    for(SDL_Rect& region : dirty) {
+      if(SDL_HasIntersection(&region, rect)) {
+        SDL_UnionRect(&region, rect, &region);
+        return;
+      }
+    }
+    if((int)dirty.size() >= MAX_DIRTY_RECTS) {
+      full = true;
+      return;
+    }
+    dirty.push_back(*rect);
+  }
+
+  void RenderCache::invalidateAll() {
+    full = true;
+  }
+
+  void RenderCache::snapshot(Entry* entry, SpriteRecord* record) {
+    entry->record = record;
+    entry->bounds = *getRecordDestRect(record);
+    entry->center = {0, 0};
+    entry->angle = 0;
+    entry->geometry = false;
+    entry->command = -1;
+    if(record->custom != NULL) {
+      // Classes that draw themselves are compared by what they report
+      SDL_Rect* src = record->custom->getSrcRect();
+      entry->texture = record->custom->getTexture();
+      entry->src = src != NULL ? *src : SDL_Rect{0, 0, 0, 0};
+      entry->dest = {0, 0, 0, 0};
+      entry->flip = record->custom->getRendererFlip();
+      entry->hasSrc = src != NULL;
+      entry->transformVersion = 0;
+      return;
+    }
+    entry->texture = record->texture;
+    entry->src = record->src;
+    entry->dest = record->dest;
+    entry->flip = record->flip;
+    entry->hasSrc = record->hasSrc;
+    entry->transformVersion = record->transform != NULL ? record->transform->getVersion() : 0;
+  }
+
+  void RenderCache::snapshot(Entry* entry, RenderCommand* command, int index) {
+    entry->record = NULL;
+    entry->texture = command->texture;
+    entry->src = command->src;
+    entry->dest = command->dest;
+    entry->flip = command->flip;
+    entry->hasSrc = command->hasSrc;
+    entry->center = command->center;
+    entry->angle = command->angle;
+    entry->geometry = command->numIndices > 0;
+    entry->command = index;
+    entry->transformVersion = 0;
+    if(entry->geometry) {
+      // Vertices are not kept, so geometry always covers the whole cache
+      entry->bounds = {0, 0, width, height};
+      return;
+    }
+
+    // Bounding box of the corners rotated about the center
+    float pivotX = command->dest.x + command->center.x;
+    float pivotY = command->dest.y + command->center.y;
+    float radians = command->angle*0.017453293f;
+    float c = cosf(radians);
+    float s = sinf(radians);
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for(int i = 0; i < 4; i++) {
+      float x = command->dest.x + (i & 1 ? command->dest.w : 0) - pivotX;
+      float y = command->dest.y + (i & 2 ? command->dest.h : 0) - pivotY;
+      float rotatedX = pivotX + x*c - y*s;
+      float rotatedY = pivotY + x*s + y*c;
+      minX = i == 0 || rotatedX < minX ? rotatedX : minX;
+      minY = i == 0 || rotatedY < minY ? rotatedY : minY;
+      maxX = i == 0 || rotatedX > maxX ? rotatedX : maxX;
+      maxY = i == 0 || rotatedY > maxY ? rotatedY : maxY;
+    }
+    entry->bounds = {(int)floorf(minX), (int)floorf(minY), (int)ceilf(maxX - floorf(minX)), (int)ceilf(maxY - floorf(minY))};
+  }
+
+  bool RenderCache::replace(Entry* entry, const Entry& current) {
+    bool different = current.geometry
+      || current.texture != entry->texture
+      || current.flip != entry->flip
+      || current.hasSrc != entry->hasSrc
+      || current.angle != entry->angle
+      || current.transformVersion != entry->transformVersion
+      || memcmp(&current.src, &entry->src, sizeof(SDL_Rect)) != 0
+      || memcmp(&current.dest, &entry->dest, sizeof(SDL_FRect)) != 0
+      || memcmp(&current.center, &entry->center, sizeof(SDL_FPoint)) != 0
+      || memcmp(&current.bounds, &entry->bounds, sizeof(SDL_Rect)) != 0;
+    if(different) {
+      invalidate(&entry->bounds);
+      invalidate(&current.bounds);
+    }
+    *entry = current;
+    return different;
+  }
+
+  bool RenderCache::changed(Entry* entry) {
+    Entry current;
+    snapshot(&current, entry->record);
+    return replace(entry, current);
+  }
+
+  void RenderCache::insert(const Entry& entry) {
+    invalidate(&entry.bounds);
+    if(count < (int)entries.size()) {
+      // The order changed, so everything after this point may overlap
+      // differently
+      invalidate(&entries[count].bounds);
+      entries[count] = entry;
+    }
+    else {
+      entries.push_back(entry);
+    }
+  }
+
+  void RenderCache::begin() {
+    count = 0;
+  }
+
+  void RenderCache::add(SpriteRecord* record) {
+    // Animated records only know their frame once resolved
+    if(record->custom == NULL && record->animation != NULL) {
+      record->animation->resolve(record->animationSlot, record);
+    }
+
+    if(count < (int)entries.size() && entries[count].record == record) {
+      changed(&entries[count]);
+    }
+    else {
+      Entry entry;
+      snapshot(&entry, record);
+      insert(entry);
+    }
+    count++;
+  }
+
+  bool RenderCache::end() {
+    for(int i = count; i < (int)entries.size(); i++) {
+      invalidate(&entries[i].bounds);
+    }
+    entries.resize(count);
+
+    if(!full && dirty.empty()) {
+      return false;
+    }
+
+    SDL_Texture* target = SDL_GetRenderTarget(renderer);
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+
+    SDL_SetRenderTarget(renderer, texture);
+    if(full) {
+      SDL_Rect all = {0, 0, width, height};
+      redraw(&all);
+    }
+    else {
+      for(SDL_Rect& region : dirty) {
+        redraw(&region);
+      }
+    }
+    SDL_RenderSetClipRect(renderer, NULL);
+
+    SDL_SetRenderTarget(renderer, target);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_SetRenderDrawBlendMode(renderer, blendMode);
+
+    dirty.clear();
+    full = false;
+    version++;
+    return true;
+  }
+
+  bool RenderCache::update(RenderCommandBuffer* commands) {
+    begin();
+    int num = commands->getCount();
+    for(int i = 0; i < num; i++) {
+      Entry entry;
+      snapshot(&entry, commands->getCommand(i), i);
+      // Commands have nothing to tell them apart, so the one in the same
+      // place is compared
+      if(count < (int)entries.size() && entries[count].record == NULL) {
+        replace(&entries[count], entry);
+      }
+      else {
+        insert(entry);
+      }
+      count++;
+    }
+    this->commands = commands;
+    bool drawn = end();
+    this->commands = NULL;
+    return drawn;
+  }
+
+  void RenderCache::redraw(const SDL_Rect* rect) {
+    SDL_RenderSetClipRect(renderer, rect);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderFillRect(renderer, rect);
+    for(Entry& entry : entries) {
+      if(!SDL_HasIntersection(&entry.bounds, rect)) {
+        continue;
+      }
+      if(entry.record != NULL) {
+        drawRecord(renderer, entry.record);
+      }
+      else {
+        commands->drawCommand(renderer, entry.command);
+      }
+    }
+  }
+
+  Uint32 RenderCache::getVersion() {
+    return version;
+  }
+
+  SDL_Texture* RenderCache::getTexture() {
+    return texture;
+  }
+}
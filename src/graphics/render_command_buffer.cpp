@@ -0,0 +1,354 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file render_command_buffer.cpp
+ *
+ * A blackhole library class for recording, sorting and submitting draws
+ */
+
+#include "graphics/render_command_buffer.h"
+#include "graphics/imageBase.h"
+#include "graphics/texture.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace blackhole::graphics {
+
+  // Written at the start of saved buffers, followed by the version
+  const char COMMAND_BUFFER_MAGIC[4] = {'B', 'H', 'C', 'B'};
+  const Uint32 COMMAND_BUFFER_VERSION = 1;
+
+  RenderCommandBuffer::RenderCommandBuffer() {
+    sortByTexture = false;
+    sorted = true;
+  }
+
+  RenderCommandBuffer::~RenderCommandBuffer() {
+    releaseTextures();
+  }
+
+  void RenderCommandBuffer::releaseTextures() {
+    for(SDL_Texture* texture : ownedTextures) {
+      destroyTexture(texture);
+    }
+    ownedTextures.clear();
+  }
+
+  void RenderCommandBuffer::clear() {
+    commands.clear();
+    vertices.clear();
+    indices.clear();
+    order.clear();
+    textureIds.clear();
+    releaseTextures();
+    sorted = true;
+  }
+
+  void RenderCommandBuffer::setSortByTexture(bool sortByTexture) {
+    this->sortByTexture = sortByTexture;
+  }
+
+  Uint64 RenderCommandBuffer::makeKey(int layer, SDL_Texture* texture) {
+    // | layer 16 | texture 16 | order of recording 32 |
+    if(layer < -32768) {
+      layer = -32768;
+    }
+    if(layer > 32767) {
+      layer = 32767;
+    }
+    Uint64 key = (Uint64)(layer + 32768) << 48;
+    if(sortByTexture) {
+      auto id = textureIds.find(texture);
+      if(id == textureIds.end()) {
+        id = textureIds.insert({texture, (Uint32)textureIds.size()}).first;
+      }
+      key |= (Uint64)(id->second & 0xFFFF) << 32;
+    }
+    return key | (Uint32)commands.size();
+  }
+
+  void RenderCommandBuffer::add(SpriteRecord* record, int layer) {
+    if(record->custom != NULL) {
+      record->custom->recordDraw(this, layer);
+      return;
+    }
+    RenderCommand command;
+    resolveRecord(record, &command.dest, &command.center, &command.angle);
+    command.texture = record->texture;
+    command.src = record->src;
+    command.flip = record->flip;
+    command.hasSrc = record->hasSrc;
+    command.numIndices = 0;
+    command.key = makeKey(layer, command.texture);
+    commands.push_back(command);
+    sorted = false;
+  }
+
+  void RenderCommandBuffer::addTexture(SDL_Texture* texture, const SDL_Rect* src, const SDL_FRect* dest, int layer, SDL_RendererFlip flip) {
+    RenderCommand command;
+    command.texture = texture;
+    command.hasSrc = src != NULL;
+    command.src = src != NULL ? *src : SDL_Rect{0, 0, 0, 0};
+    command.dest = *dest;
+    command.center = {0, 0};
+    command.angle = 0;
+    command.flip = flip;
+    command.numIndices = 0;
+    command.key = makeKey(layer, texture);
+    commands.push_back(command);
+    sorted = false;
+  }
+
+  void RenderCommandBuffer::addGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int numVertices, const int* indices, int numIndices, int layer) {
+    RenderCommand command;
+    command.texture = texture;
+    command.firstVertex = this->vertices.size();
+    command.numVertices = numVertices;
+    command.firstIndex = this->indices.size();
+    command.numIndices = numIndices;
+    this->vertices.insert(this->vertices.end(), vertices, vertices + numVertices);
+    this->indices.insert(this->indices.end(), indices, indices + numIndices);
+    command.key = makeKey(layer, texture);
+    commands.push_back(command);
+    sorted = false;
+  }
+
+  void RenderCommandBuffer::setTexture(int index, SDL_Texture* texture) {
+    RenderCommand& command = commands[index];
+    int layer = (int)(command.key >> 48) - 32768;
+    command.texture = texture;
+    // The command keeps its place in the order of recording
+    command.key = (makeKey(layer, texture) & ~(Uint64)0xFFFFFFFF) | (command.key & 0xFFFFFFFF);
+    sorted = false;
+  }
+
+  void RenderCommandBuffer::append(RenderCommandBuffer* other) {
+    int vertexBase = vertices.size();
+    int indexBase = indices.size();
+    for(RenderCommand& command : other->commands) {
+      int layer = (int)(command.key >> 48) - 32768;
+      command.key = makeKey(layer, command.texture);
+      if(command.numIndices > 0) {
+        command.firstVertex += vertexBase;
+        command.firstIndex += indexBase;
+      }
+      commands.push_back(command);
+    }
+    vertices.insert(vertices.end(), other->vertices.begin(), other->vertices.end());
+    indices.insert(indices.end(), other->indices.begin(), other->indices.end());
+    other->clear();
+    sorted = false;
+  }
+
+  void RenderCommandBuffer::sort() {
+    if(sorted && order.size() == commands.size()) {
+      return;
+    }
+    int count = commands.size();
+    order.resize(count);
+    scratch.resize(count);
+    for(int i = 0; i < count; i++) {
+      order[i] = {commands[i].key, (Uint32)i};
+    }
+
+    // Least significant byte first, skipping bytes that are the same in
+    // every key
+    int histogram[256];
+    for(int shift = 0; shift < 64; shift += 8) {
+      memset(histogram, 0, sizeof(histogram));
+      for(int i = 0; i < count; i++) {
+        histogram[(order[i].key >> shift) & 0xFF]++;
+      }
+      if(count == 0 || histogram[(order[0].key >> shift) & 0xFF] == count) {
+        continue;
+      }
+      int offset = 0;
+      for(int b = 0; b < 256; b++) {
+        int size = histogram[b];
+        histogram[b] = offset;
+        offset += size;
+      }
+      for(int i = 0; i < count; i++) {
+        scratch[histogram[(order[i].key >> shift) & 0xFF]++] = order[i];
+      }
+      order.swap(scratch);
+    }
+    sorted = true;
+  }
+
+  void RenderCommandBuffer::draw(SDL_Renderer* renderer, RenderCommand& command) {
+    if(command.numIndices > 0) {
+      SDL_RenderGeometry(renderer, command.texture, &vertices[command.firstVertex], command.numVertices, &indices[command.firstIndex], command.numIndices);
+      return;
+    }
+    const SDL_Rect* src = command.hasSrc ? &command.src : NULL;
+    SDL_RenderCopyExF(renderer, command.texture, src, &command.dest, command.angle, &command.center, command.flip);
+  }
+
+  void RenderCommandBuffer::submit(SDL_Renderer* renderer, FrameStats* stats) {
+    sort();
+    SDL_Texture* bound = NULL;
+    for(SortEntry& entry : order) {
+      RenderCommand& command = commands[entry.command];
+      draw(renderer, command);
+      if(stats == NULL) {
+        continue;
+      }
+      stats->drawCalls++;
+      if(command.texture != bound) {
+        stats->textureBinds++;
+        bound = command.texture;
+      }
+    }
+  }
+
+  void RenderCommandBuffer::drawCommand(SDL_Renderer* renderer, int index) {
+    sort();
+    draw(renderer, commands[order[index].command]);
+  }
+
+  int RenderCommandBuffer::getCount() {
+    return commands.size();
+  }
+
+  RenderCommand* RenderCommandBuffer::getCommand(int index) {
+    sort();
+    return &commands[order[index].command];
+  }
+
+  bool RenderCommandBuffer::save(const char* file) {
+    FILE* out = fopen(file, "wb");
+    if(out == NULL) {
+      printf("Failed to open %s for writing\n", file);
+      return false;
+    }
+    sort();
+
+    std::unordered_map<SDL_Texture*, Uint32> ids;
+    std::vector<SDL_Texture*> textures;
+    Uint32 count = 0;
+    for(RenderCommand& command : commands) {
+      if(command.numIndices > 0) {
+        continue;
+      }
+      count++;
+      if(ids.find(command.texture) == ids.end()) {
+        ids[command.texture] = textures.size();
+        textures.push_back(command.texture);
+      }
+    }
+
+    fwrite(COMMAND_BUFFER_MAGIC, 1, 4, out);
+    fwrite(&COMMAND_BUFFER_VERSION, sizeof(Uint32), 1, out);
+    Uint32 numTextures = textures.size();
+    fwrite(&numTextures, sizeof(Uint32), 1, out);
+    for(SDL_Texture* texture : textures) {
+      Sint32 size[2] = {0, 0};
+      queryTexture(texture, NULL, NULL, &size[0], &size[1]);
+      fwrite(size, sizeof(Sint32), 2, out);
+    }
+    fwrite(&count, sizeof(Uint32), 1, out);
+    for(SortEntry& entry : order) {
+      RenderCommand& command = commands[entry.command];
+      if(command.numIndices > 0) {
+        continue;
+      }
+      Uint32 texture = ids[command.texture];
+      Uint32 flags = command.flip | (command.hasSrc ? 0x100 : 0);
+      fwrite(&command.key, sizeof(Uint64), 1, out);
+      fwrite(&texture, sizeof(Uint32), 1, out);
+      fwrite(&flags, sizeof(Uint32), 1, out);
+      fwrite(&command.src, sizeof(SDL_Rect), 1, out);
+      fwrite(&command.dest, sizeof(SDL_FRect), 1, out);
+      fwrite(&command.center, sizeof(SDL_FPoint), 1, out);
+      fwrite(&command.angle, sizeof(float), 1, out);
+    }
+
+    bool ok = ferror(out) == 0;
+    fclose(out);
+    if(!ok) {
+      printf("Failed to write %s\n", file);
+    }
+    return ok;
+  }
+
+  bool RenderCommandBuffer::load(const char* file, SDL_Renderer* renderer) {
+    FILE* in = fopen(file, "rb");
+    if(in == NULL) {
+      printf("Failed to open %s\n", file);
+      return false;
+    }
+    clear();
+
+    char magic[4];
+    Uint32 version = 0;
+    Uint32 numTextures = 0;
+    bool ok = fread(magic, 1, 4, in) == 4
+      && memcmp(magic, COMMAND_BUFFER_MAGIC, 4) == 0
+      && fread(&version, sizeof(Uint32), 1, in) == 1
+      && version == COMMAND_BUFFER_VERSION
+      && fread(&numTextures, sizeof(Uint32), 1, in) == 1;
+
+    for(Uint32 i = 0; ok && i < numTextures; i++) {
+      Sint32 size[2];
+      ok = fread(size, sizeof(Sint32), 2, in) == 2;
+      if(ok) {
+        ownedTextures.push_back(createTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size[0], size[1]));
+      }
+    }
+
+    Uint32 count = 0;
+    ok = ok && fread(&count, sizeof(Uint32), 1, in) == 1;
+    for(Uint32 i = 0; ok && i < count; i++) {
+      RenderCommand command;
+      Uint32 texture;
+      Uint32 flags;
+      ok = fread(&command.key, sizeof(Uint64), 1, in) == 1
+        && fread(&texture, sizeof(Uint32), 1, in) == 1
+        && fread(&flags, sizeof(Uint32), 1, in) == 1
+        && fread(&command.src, sizeof(SDL_Rect), 1, in) == 1
+        && fread(&command.dest, sizeof(SDL_FRect), 1, in) == 1
+        && fread(&command.center, sizeof(SDL_FPoint), 1, in) == 1
+        && fread(&command.angle, sizeof(float), 1, in) == 1
+        && texture < numTextures;
+      if(ok) {
+        command.texture = ownedTextures[texture];
+        command.flip = (SDL_RendererFlip)(flags & 0xFF);
+        command.hasSrc = (flags & 0x100) != 0;
+        command.numIndices = 0;
+        commands.push_back(command);
+      }
+    }
+    fclose(in);
+
+    if(!ok) {
+      printf("Failed to read command buffer %s\n", file);
+      clear();
+      return false;
+    }
+    sorted = false;
+    return true;
+  }
+}
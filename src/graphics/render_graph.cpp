@@ -0,0 +1,143 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file render_graph.cpp
+ *
+ * A blackhole library class for scheduling render passes
+ */
+
+#include "graphics/render_graph.h"
+
+namespace blackhole::graphics {
+
+  RenderGraph::RenderGraph(SDL_Renderer* renderer, RenderTargetPool* pool) {
+    this->renderer = renderer;
+    this->pool = pool;
+    this->executed = 0;
+    this->targetSwitches = 0;
+    resources.push_back({NULL, 0, 0, 0, false, true, -1, -1});
+  }
+
+  RenderResource RenderGraph::createTarget(int w, int h, Uint32 format) {
+    resources.push_back({NULL, w, h, format, true, false, -1, -1});
+    return resources.size() - 1;
+  }
+
+  RenderResource RenderGraph::importTexture(SDL_Texture* texture) {
+    resources.push_back({texture, 0, 0, 0, false, true, -1, -1});
+    return resources.size() - 1;
+  }
+
+  void RenderGraph::addPass(const char* name, std::initializer_list<RenderResource> inputs, RenderResource output, RenderPassFunction execute) {
+    Pass pass = {name, (int)this->inputs.size(), (int)inputs.size(), output, execute, false};
+    this->inputs.insert(this->inputs.end(), inputs.begin(), inputs.end());
+    passes.push_back(pass);
+  }
+
+  void RenderGraph::touch(RenderResource resource, int pass) {
+    Resource& r = resources[resource];
+    if(r.first < 0) {
+      r.first = pass;
+    }
+    r.last = pass;
+  }
+
+  void RenderGraph::execute() {
+    // Walk back from the outputs that are kept, so a pass is alive only
+    // if something alive reads what it writes
+    for(int i = passes.size() - 1; i >= 0; i--) {
+      Pass& pass = passes[i];
+      pass.alive = resources[pass.output].needed;
+      if(pass.alive) {
+        for(int j = 0; j < pass.numInputs; j++) {
+          resources[inputs[pass.firstInput + j]].needed = true;
+        }
+      }
+    }
+
+    for(int i = 0; i < (int)passes.size(); i++) {
+      if(passes[i].alive) {
+        for(int j = 0; j < passes[i].numInputs; j++) {
+          touch(inputs[passes[i].firstInput + j], i);
+        }
+        touch(passes[i].output, i);
+      }
+    }
+
+    executed = 0;
+    targetSwitches = 0;
+    SDL_Texture* current = SDL_GetRenderTarget(renderer);
+    bool targetSet = false;
+    for(int i = 0; i < (int)passes.size(); i++) {
+      Pass& pass = passes[i];
+      if(!pass.alive) {
+        continue;
+      }
+      for(Resource& resource : resources) {
+        if(resource.transient && resource.first == i) {
+          resource.texture = pool->acquire(resource.w, resource.h, resource.format);
+        }
+      }
+
+      // Passes drawing to the same target back to back do not switch
+      SDL_Texture* target = resources[pass.output].texture;
+      if(!targetSet || target != current) {
+        SDL_SetRenderTarget(renderer, target);
+        targetSwitches++;
+        current = target;
+        targetSet = true;
+      }
+      pass.execute(renderer, this);
+      executed++;
+
+      for(Resource& resource : resources) {
+        if(resource.transient && resource.last == i) {
+          pool->release(resource.texture);
+        }
+      }
+    }
+    if(current != NULL) {
+      SDL_SetRenderTarget(renderer, NULL);
+      targetSwitches++;
+    }
+
+    passes.clear();
+    inputs.clear();
+    resources.resize(1);
+    pool->endFrame();
+  }
+
+  SDL_Texture* RenderGraph::getTexture(RenderResource resource) {
+    return resources[resource].texture;
+  }
+
+  int RenderGraph::getExecutedPasses() {
+    return executed;
+  }
+
+  int RenderGraph::getTargetSwitches() {
+    return targetSwitches;
+  }
+}
@@ -0,0 +1,91 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file render_target_pool.cpp
+ *
+ * A blackhole library class for sharing render target textures
+ */
+
+#include "graphics/render_target_pool.h"
+#include "graphics/texture.h"
+#include <stdio.h>
+
+namespace blackhole::graphics {
+
+  RenderTargetPool::RenderTargetPool(SDL_Renderer* renderer, int maxUnusedFrames) {
+    this->renderer = renderer;
+    this->maxUnusedFrames = maxUnusedFrames;
+  }
+
+  RenderTargetPool::~RenderTargetPool() {
+    for(Target& target : targets) {
+      destroyTexture(target.texture);
+    }
+  }
+
+  SDL_Texture* RenderTargetPool::acquire(int w, int h, Uint32 format) {
+    for(Target& target : targets) {
+      if(!target.used && target.w == w && target.h == h && target.format == format) {
+        target.used = true;
+        target.unusedFrames = 0;
+        return target.texture;
+      }
+    }
+
+    SDL_Texture* texture = createTexture(renderer, format, SDL_TEXTUREACCESS_TARGET, w, h);
+    if(texture == NULL) {
+      printf("Failed to create render target: %s\n", SDL_GetError());
+      return NULL;
+    }
+    targets.push_back({texture, w, h, format, true, 0});
+    return texture;
+  }
+
+  void RenderTargetPool::release(SDL_Texture* texture) {
+    for(Target& target : targets) {
+      if(target.texture == texture) {
+        target.used = false;
+        return;
+      }
+    }
+  }
+
+  void RenderTargetPool::endFrame() {
+    for(size_t i = 0; i < targets.size();) {
+      if(!targets[i].used && ++targets[i].unusedFrames > maxUnusedFrames) {
+        destroyTexture(targets[i].texture);
+        targets[i] = targets.back();
+        targets.pop_back();
+      }
+      else {
+        i++;
+      }
+    }
+  }
+
+  int RenderTargetPool::getCount() {
+    return targets.size();
+  }
+}
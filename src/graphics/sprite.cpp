@@ -0,0 +1,105 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file sprite.cpp
+ *
+ * A blackhole library class for drawing one frame of a shared SpriteSheet
+ */
+
+#include "graphics/sprite.h"
+
+namespace blackhole::graphics {
+  Sprite::Sprite(SpriteSheet* sheet, float x, float y, int frame) {
+    this->sheet = sheet;
+    this->x = x;
+    this->y = y;
+    setCustomDraw(false);
+    record.hasSrc = true;
+    record.texture = sheet->getTexture();
+    setFrame(frame);
+  }
+
+  Sprite::~Sprite() {
+  }
+
+  void Sprite::setFrame(int frame) {
+    this->frame = frame;
+    this->srcRect = sheet->getFrameRect(frame);
+    this->offset = sheet->getFrameOffset(frame);
+    this->destRect.w = srcRect.w;
+    this->destRect.h = srcRect.h;
+    updateRecord();
+  }
+
+  void Sprite::updateRecord() {
+    record.src = srcRect;
+    record.dest = {
+      x + offset.x,
+      y + offset.y,
+      (float)srcRect.w,
+      (float)srcRect.h
+    };
+  }
+
+  int Sprite::getFrame() {
+    return frame;
+  }
+
+  SpriteSheet* Sprite::getSpriteSheet() {
+    return sheet;
+  }
+
+  void Sprite::setX(float x) {
+    this->x = x;
+    updateRecord();
+  }
+
+  void Sprite::setY(float y) {
+    this->y = y;
+    updateRecord();
+  }
+
+  float Sprite::getX() {
+    return x;
+  }
+
+  float Sprite::getY() {
+    return y;
+  }
+
+  SDL_Texture* Sprite::getTexture() {
+    return sheet->getTexture();
+  }
+
+  SDL_Rect* Sprite::getDestRect() {
+    destRect.x = round(x) + offset.x;
+    destRect.y = round(y) + offset.y;
+    return &destRect;
+  }
+
+  SDL_Rect* Sprite::getSrcRect() {
+    return &srcRect;
+  }
+}
@@ -0,0 +1,412 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file sprite_atlas.cpp
+ *
+ * A blackhole library class for loading Aseprite and TexturePacker atlases
+ */
+
+#include "graphics/sprite_atlas.h"
+#include <fstream>
+#include <sstream>
+#include <stdlib.h>
+#include <string.h>
+
+namespace blackhole::graphics {
+
+  namespace {
+
+    /**
+     *  \brief The subset of JSON needed to read atlas exports. Objects
+     *         keep their key order because Aseprite orders frames by it
+     */
+    struct JsonValue {
+      enum Type { JSON_NULL, JSON_BOOL, JSON_NUMBER, JSON_STRING, JSON_ARRAY, JSON_OBJECT };
+      Type type = JSON_NULL;
+      bool boolean = false;
+      double number = 0;
+      std::string string;
+      std::vector<JsonValue> array;
+      std::vector<std::pair<std::string, JsonValue>> object;
+
+      const JsonValue* get(const char* key) const {
+        for(const auto& member : object) {
+          if(member.first == key) {
+            return &member.second;
+          }
+        }
+        return NULL;
+      }
+
+      double getNumber(const char* key, double fallback = 0) const {
+        const JsonValue* value = get(key);
+        return value != NULL && value->type == JSON_NUMBER ? value->number : fallback;
+      }
+
+      bool getBool(const char* key) const {
+        const JsonValue* value = get(key);
+        return value != NULL && value->type == JSON_BOOL && value->boolean;
+      }
+
+      std::string getString(const char* key) const {
+        const JsonValue* value = get(key);
+        return value != NULL && value->type == JSON_STRING ? value->string : "";
+      }
+    };
+
+    class JsonParser {
+    private:
+      const char* text;
+
+      void skipSpace() {
+        while(*text == ' ' || *text == '\t' || *text == '\n' || *text == '\r') {
+          text++;
+        }
+      }
+
+      bool parseString(std::string& out) {
+        if(*text != '"') {
+          return false;
+        }
+        text++;
+        while(*text != '"') {
+          if(*text == '\0') {
+            return false;
+          }
+          if(*text == '\\') {
+            text++;
+            switch(*text) {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u':
+              // Atlas names are ASCII so escaped code points are kept as ?
+              for(int i = 0; i < 4 && text[1] != '\0'; i++) {
+                text++;
+              }
+              out += '?';
+              break;
+            case '\0': return false;
+            default: out += *text; break;
+            }
+            text++;
+            continue;
+          }
+          out += *text++;
+        }
+        text++;
+        return true;
+      }
+
+    public:
+      JsonParser(const char* text) {
+        this->text = text;
+      }
+
+      bool parse(JsonValue& value) {
+        skipSpace();
+        switch(*text) {
+        case '{':
+          value.type = JsonValue::JSON_OBJECT;
+          text++;
+          skipSpace();
+          if(*text == '}') {
+            text++;
+            return true;
+          }
+          while(true) {
+            std::string key;
+            skipSpace();
+            if(!parseString(key)) {
+              return false;
+            }
+            skipSpace();
+            if(*text++ != ':') {
+              return false;
+            }
+            value.object.push_back({key, JsonValue()});
+            if(!parse(value.object.back().second)) {
+              return false;
+            }
+            skipSpace();
+            if(*text == ',') {
+              text++;
+              continue;
+            }
+            return *text++ == '}';
+          }
+        case '[':
+          value.type = JsonValue::JSON_ARRAY;
+          text++;
+          skipSpace();
+          if(*text == ']') {
+            text++;
+            return true;
+          }
+          while(true) {
+            value.array.push_back(JsonValue());
+            if(!parse(value.array.back())) {
+              return false;
+            }
+            skipSpace();
+            if(*text == ',') {
+              text++;
+              continue;
+            }
+            return *text++ == ']';
+          }
+        case '"':
+          value.type = JsonValue::JSON_STRING;
+          return parseString(value.string);
+        case 't':
+        case 'f':
+          value.type = JsonValue::JSON_BOOL;
+          value.boolean = *text == 't';
+          if(strncmp(text, value.boolean ? "true" : "false", value.boolean ? 4 : 5) != 0) {
+            return false;
+          }
+          text += value.boolean ? 4 : 5;
+          return true;
+        case 'n':
+          if(strncmp(text, "null", 4) != 0) {
+            return false;
+          }
+          text += 4;
+          return true;
+        default: {
+          char* end;
+          value.type = JsonValue::JSON_NUMBER;
+          value.number = strtod(text, &end);
+          if(end == text) {
+            return false;
+          }
+          text = end;
+          return true;
+        }
+        }
+      }
+    };
+
+    bool readFrame(const JsonValue& frame, SpriteFrame* out) {
+      if(frame.getBool("rotated")) {
+        // A rotated frame is stored turned 90 degrees in the image, which
+        // a SpriteSheet rect can not describe
+        return false;
+      }
+      *out = {{0, 0, 0, 0}, {0, 0}, 0};
+      const JsonValue* rect = frame.get("frame");
+      if(rect != NULL) {
+        out->rect = {
+          (int)rect->getNumber("x"),
+          (int)rect->getNumber("y"),
+          (int)rect->getNumber("w"),
+          (int)rect->getNumber("h")
+        };
+      }
+      const JsonValue* source = frame.get("spriteSourceSize");
+      if(frame.getBool("trimmed") && source != NULL) {
+        out->offset = {(int)source->getNumber("x"), (int)source->getNumber("y")};
+      }
+      // Aseprite durations are in milliseconds
+      out->duration = frame.getNumber("duration")/1000.0f;
+      return true;
+    }
+  }
+
+  SpriteAtlas::SpriteAtlas(const char* file, SDL_Renderer* renderer) {
+    sheet = NULL;
+
+    std::ifstream stream(file);
+    if(!stream) {
+      printf("File %s not found\n", file);
+      return;
+    }
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    std::string text = buffer.str();
+
+    JsonValue root;
+    if(!JsonParser(text.c_str()).parse(root) || root.type != JsonValue::JSON_OBJECT) {
+      printf("Unable to Parse Atlas %s\n", file);
+      return;
+    }
+
+    // Frames are an array of objects with a filename in the array export
+    // and an object keyed by filename in the hash export. Skipped frames
+    // map to -1 so tags still find the frames after them
+    std::vector<SpriteFrame> frames;
+    std::vector<int> frameMap;
+    auto addFrame = [&](const std::string& name, const JsonValue& frame) {
+      SpriteFrame out;
+      if(!readFrame(frame, &out)) {
+        printf("Skipping rotated frame %s in Atlas %s\n", name.c_str(), file);
+        frameMap.push_back(-1);
+        return;
+      }
+      frameMap.push_back(frames.size());
+      frameNames.push_back(name);
+      frames.push_back(out);
+    };
+    const JsonValue* frameData = root.get("frames");
+    if(frameData != NULL && frameData->type == JsonValue::JSON_ARRAY) {
+      for(const JsonValue& frame : frameData->array) {
+        addFrame(frame.getString("filename"), frame);
+      }
+    }
+    else if(frameData != NULL && frameData->type == JsonValue::JSON_OBJECT) {
+      for(const auto& frame : frameData->object) {
+        addFrame(frame.first, frame.second);
+      }
+    }
+    if(frames.empty()) {
+      printf("No Frames in Atlas %s\n", file);
+      return;
+    }
+
+    const JsonValue* meta = root.get("meta");
+    std::string image = meta != NULL ? meta->getString("image") : "";
+    std::string path = file;
+    size_t slash = path.find_last_of("/");
+    image = slash == std::string::npos ? image : path.substr(0, slash + 1) + image;
+    sheet = new SpriteSheet(image.c_str(), renderer, frames);
+
+    // Aseprite tags are frame ranges with a direction
+    const JsonValue* frameTags = meta != NULL ? meta->get("frameTags") : NULL;
+    if(frameTags != NULL) {
+      for(const JsonValue& frameTag : frameTags->array) {
+        AnimationTag tag;
+        tag.name = frameTag.getString("name");
+        tag.id = animationId(tag.name.c_str());
+        int from = frameTag.getNumber("from");
+        int to = frameTag.getNumber("to");
+        std::string direction = frameTag.getString("direction");
+
+        for(int i = from; i <= to; i++) {
+          if(i >= 0 && i < (int)frameMap.size() && frameMap[i] >= 0) {
+            tag.frames.push_back(frameMap[i]);
+          }
+        }
+        if(direction == "reverse" || direction == "pingpong_reverse") {
+          std::vector<int> reversed(tag.frames.rbegin(), tag.frames.rend());
+          tag.frames = reversed;
+        }
+        if(direction == "pingpong" || direction == "pingpong_reverse") {
+          for(int i = tag.frames.size() - 2; i > 0; i--) {
+            tag.frames.push_back(tag.frames[i]);
+          }
+        }
+
+        if(tag.frames.empty()) {
+          printf("Tag %s in Atlas %s has no frames\n", tag.name.c_str(), file);
+          continue;
+        }
+        tagIndex.insert({tag.id, (int)tags.size()});
+        tags.push_back(tag);
+      }
+    }
+
+    // TexturePacker animations are lists of frame names
+    const JsonValue* animations = root.get("animations");
+    if(animations != NULL) {
+      for(const auto& animation : animations->object) {
+        AnimationTag tag;
+        tag.name = animation.first;
+        tag.id = animationId(tag.name.c_str());
+        for(const JsonValue& name : animation.second.array) {
+          int frame = getFrame(name.string.c_str());
+          if(frame >= 0) {
+            tag.frames.push_back(frame);
+          }
+        }
+
+        if(tag.frames.empty()) {
+          printf("Tag %s in Atlas %s has no frames\n", tag.name.c_str(), file);
+          continue;
+        }
+        tagIndex.insert({tag.id, (int)tags.size()});
+        tags.push_back(tag);
+      }
+    }
+  }
+
+  SpriteAtlas::~SpriteAtlas() {
+    delete sheet;
+  }
+
+  SpriteSheet* SpriteAtlas::getSpriteSheet() {
+    return sheet;
+  }
+
+  int SpriteAtlas::getFrame(const char* name) {
+    for(size_t i = 0; i < frameNames.size(); i++) {
+      if(frameNames[i] == name) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  const AnimationTag* SpriteAtlas::getTag(AnimationId tag) {
+    auto index = tagIndex.find(tag);
+    return index != tagIndex.end() ? &tags[index->second] : NULL;
+  }
+
+  int SpriteAtlas::getNumTags() {
+    return tags.size();
+  }
+
+  const AnimationTag* SpriteAtlas::getTagAt(int index) {
+    if(index < 0 || index >= (int)tags.size()) {
+      return NULL;
+    }
+    return &tags[index];
+  }
+
+  Animation* SpriteAtlas::createAnimation(AnimationId tag, float speed, AnimationSystem* system) {
+    if(sheet == NULL) {
+      printf("Atlas was not loaded, no Animation for tag %08x\n", tag);
+      return NULL;
+    }
+    // Tags without frames are dropped when loading
+    const AnimationTag* found = getTag(tag);
+    if(found == NULL) {
+      printf("Animation tag %08x not found in Atlas\n", tag);
+      return NULL;
+    }
+    std::vector<int> frames = found->frames;
+
+    if(speed <= 0) {
+      for(int frame : frames) {
+        if(sheet->getFrameDuration(frame) <= 0) {
+          speed = 0.1f;
+          break;
+        }
+      }
+    }
+    return new Animation(sheet, frames[0], frames.data(), frames.size(), speed, system);
+  }
+}
@@ -0,0 +1,112 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file sprite_record.cpp
+ *
+ * A blackhole library struct holding everything needed to draw an ImageBase
+ */
+
+#include "graphics/sprite_record.h"
+#include "graphics/animation_system.h"
+#include "graphics/imageBase.h"
+#include "graphics/transform.h"
+#include <math.h>
+
+namespace blackhole::graphics {
+
+  SDL_Rect* getRecordDestRect(SpriteRecord* record) {
+    if(record->custom != NULL) {
+      return record->custom->getDestRect();
+    }
+    if(record->transform == NULL) {
+      float left = floorf(record->dest.x);
+      float top = floorf(record->dest.y);
+      record->bounds = {
+        (int)left,
+        (int)top,
+        (int)ceilf(record->dest.x + record->dest.w - left),
+        (int)ceilf(record->dest.y + record->dest.h - top)
+      };
+      return &record->bounds;
+    }
+
+    // Bounding box of the rotated corners
+    float left = record->dest.x;
+    float top = record->dest.y;
+    float right = left + record->dest.w;
+    float bottom = top + record->dest.h;
+    SDL_FPoint corners[4] = {
+      record->transform->apply(left, top),
+      record->transform->apply(right, top),
+      record->transform->apply(left, bottom),
+      record->transform->apply(right, bottom)
+    };
+    float minX = corners[0].x, maxX = corners[0].x;
+    float minY = corners[0].y, maxY = corners[0].y;
+    for(int i = 1; i < 4; i++) {
+      minX = fminf(minX, corners[i].x);
+      maxX = fmaxf(maxX, corners[i].x);
+      minY = fminf(minY, corners[i].y);
+      maxY = fmaxf(maxY, corners[i].y);
+    }
+    record->bounds = {(int)floorf(minX), (int)floorf(minY), (int)ceilf(maxX - floorf(minX)), (int)ceilf(maxY - floorf(minY))};
+    return &record->bounds;
+  }
+
+  void resolveRecord(SpriteRecord* record, SDL_FRect* dest, SDL_FPoint* center, float* angle) {
+    if(record->animation != NULL) {
+      record->animation->resolve(record->animationSlot, record);
+    }
+    if(record->transform == NULL) {
+      *dest = record->dest;
+      *center = {record->dest.w / 2, record->dest.h / 2};
+      *angle = 0;
+      return;
+    }
+
+    // Scale the rect about the node, then let SDL rotate it about the node
+    const WorldTransform* world = record->transform->getWorld();
+    *dest = {
+      world->x + record->dest.x * world->scaleX,
+      world->y + record->dest.y * world->scaleY,
+      record->dest.w * world->scaleX,
+      record->dest.h * world->scaleY
+    };
+    *center = {-record->dest.x * world->scaleX, -record->dest.y * world->scaleY};
+    *angle = world->rotation;
+  }
+
+  void drawRecord(SDL_Renderer* renderer, SpriteRecord* record) {
+    if(record->custom != NULL) {
+      record->custom->draw(renderer);
+      return;
+    }
+    SDL_FRect dest;
+    SDL_FPoint center;
+    float angle;
+    resolveRecord(record, &dest, &center, &angle);
+    SDL_RenderCopyExF(renderer, record->texture, record->hasSrc ? &record->src : NULL, &dest, angle, &center, record->flip);
+  }
+}
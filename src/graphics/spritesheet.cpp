@@ -29,6 +29,8 @@
  */
 
 #include "graphics/spritesheet.h"
+#include "graphics/texture.h"
+#include <stdio.h>
 
 namespace blackhole::graphics {
   SpriteSheet::SpriteSheet(const char* file, SDL_Renderer* renderer,
@@ -36,38 +38,165 @@ namespace blackhole::graphics {
 						   int cols, int rows
 						   ) {
 	init(file, renderer);
+	setCustomDraw(false);
 	this->x = x;
 	this->y = y;
 	
+	if(cols < 1 || rows < 1) {
+	  printf("SpriteSheet %s needs at least 1 column and row\n", file != NULL ? file : "");
+	  cols = cols < 1 ? 1 : cols;
+	  rows = rows < 1 ? 1 : rows;
+	}
 	this->rows = rows;
 	this->cols = cols;
 
-	SDL_QueryTexture(texture, NULL, NULL, &col_size, &row_size);
+	queryTexture(texture, NULL, NULL, &col_size, &row_size);
 	
 	this->row_size /= rows;
 	this->col_size /= cols;
 
 	this->frames = rows*cols;
 
+	// Every frame rect is built once here so setFrame is a table lookup
+	frameRects.resize(frames);
+	for(int i = 0; i < frames; i++) {
+	  frameRects[i] = {
+		i%cols*col_size,
+		i/cols*row_size,
+		col_size,
+		row_size
+	  };
+	}
+
+	frameOffsets.assign(frames, {0, 0});
+	frameDurations.assign(frames, 0);
+
+	this->frame = 0;
 	this->destRect.w = col_size;
 	this->destRect.h = row_size;
 	this->srcRect = {0, 0, col_size, row_size};
+	updateRecord();
+  }
+
+  SpriteSheet::SpriteSheet(const char* file, SDL_Renderer* renderer,
+						   const std::vector<SDL_Rect>& frames,
+						   float x, float y
+						   ) {
+	init(file, renderer);
+	setCustomDraw(false);
+	this->x = x;
+	this->y = y;
+
+	frameRects = frames;
+	if(frameRects.empty()) {
+	  frameRects.push_back(getWholeImage(file));
+	}
+	frameOffsets.assign(frameRects.size(), {0, 0});
+	frameDurations.assign(frameRects.size(), 0);
+
+	this->rows = 1;
+	this->cols = frameRects.size();
+	this->col_size = frameRects[0].w;
+	this->row_size = frameRects[0].h;
+	this->frames = frameRects.size();
+
+	this->frame = 0;
+	this->srcRect = frameRects[0];
+	this->destRect.w = srcRect.w;
+	this->destRect.h = srcRect.h;
+	updateRecord();
+  }
+
+  SpriteSheet::SpriteSheet(const char* file, SDL_Renderer* renderer,
+						   const std::vector<SpriteFrame>& frames,
+						   float x, float y
+						   ) {
+	init(file, renderer);
+	setCustomDraw(false);
+	this->x = x;
+	this->y = y;
+
+	for(const SpriteFrame& frame : frames) {
+	  frameRects.push_back(frame.rect);
+	  frameOffsets.push_back(frame.offset);
+	  frameDurations.push_back(frame.duration);
+	}
+	if(frameRects.empty()) {
+	  frameRects.push_back(getWholeImage(file));
+	  frameOffsets.push_back({0, 0});
+	  frameDurations.push_back(0);
+	}
+
+	this->rows = 1;
+	this->cols = frameRects.size();
+	this->col_size = frameRects[0].w;
+	this->row_size = frameRects[0].h;
+	this->frames = frameRects.size();
+
+	this->frame = 0;
+	this->srcRect = frameRects[0];
+	this->destRect.w = srcRect.w;
+	this->destRect.h = srcRect.h;
+	updateRecord();
   }
 
   SpriteSheet::~SpriteSheet() {
   }
 
+  SDL_Rect SpriteSheet::getWholeImage(const char* file) {
+    // An empty frame list would leave nothing to wrap frames to
+    printf("SpriteSheet %s has no frames, using the whole image\n", file != NULL ? file : "");
+    SDL_Rect whole = {0, 0, 0, 0};
+    queryTexture(texture, NULL, NULL, &whole.w, &whole.h);
+    return whole;
+  }
+
   void SpriteSheet::setFrame(int frame) {
-    frame = frame % frames < 0 ? frame + frames : frame % frames;
-    this->frame = frame;
-    this->srcRect = {
-      frame%cols*col_size,
-      (int)frame/cols*row_size,
-      col_size,
-      row_size
+    this->frame = wrapFrame(frame);
+    this->srcRect = frameRects[this->frame];
+    this->destRect.w = srcRect.w;
+    this->destRect.h = srcRect.h;
+    updateRecord();
+  }
+
+  void SpriteSheet::updateRecord() {
+    record.hasSrc = true;
+    record.src = srcRect;
+    record.dest = {
+      x + frameOffsets[frame].x,
+      y + frameOffsets[frame].y,
+      (float)srcRect.w,
+      (float)srcRect.h
     };
   }
 
+  int SpriteSheet::wrapFrame(int frame) {
+    if(frame < 0 || frame >= frames) {
+      frame = frame % frames < 0 ? frame % frames + frames : frame % frames;
+    }
+    return frame;
+  }
+
+  SDL_Rect SpriteSheet::getFrameRect(int frame) {
+    return frameRects[wrapFrame(frame)];
+  }
+
+  SDL_Point SpriteSheet::getFrameOffset(int frame) {
+    return frameOffsets[wrapFrame(frame)];
+  }
+
+  float SpriteSheet::getFrameDuration(int frame) {
+    return frameDurations[wrapFrame(frame)];
+  }
+
+  int SpriteSheet::getFrameCount() {
+    return frames;
+  }
+
+  const SDL_Rect* SpriteSheet::getFrameTable() {
+    return frameRects.data();
+  }
+
   int SpriteSheet::getFrame() {
 	return frame;
   }
@@ -75,10 +204,12 @@ namespace blackhole::graphics {
   
   void SpriteSheet::setX(float x) {
 	this->x = x;
+	updateRecord();
   }
 
   void SpriteSheet::setY(float y) {
 	this->y = y;
+	updateRecord();
   }
 
   float SpriteSheet::getX() {
@@ -90,8 +221,8 @@ namespace blackhole::graphics {
   }
 
   SDL_Rect* SpriteSheet::getDestRect() {
-	destRect.x = (int)x+0.5;
-	destRect.y = (int)y+0.5;
+	destRect.x = round(x) + frameOffsets[frame].x;
+	destRect.y = round(y) + frameOffsets[frame].y;
 	return &destRect;
   }
   
@@ -0,0 +1,162 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file stats_overlay.cpp
+ *
+ * A blackhole library class for drawing frame statistics over a window
+ */
+
+#include "graphics/stats_overlay.h"
+#include <stdio.h>
+
+namespace blackhole::graphics {
+
+  // The graph shows one bar per frame up to twice the budget
+  const int GRAPH_FRAMES = 120;
+  const int GRAPH_HEIGHT = 40;
+  const int LINE_HEIGHT = 7;
+  const int LINES = 5;
+
+  // 3x5 glyphs, the top row in the highest bits
+  static Uint16 getGlyph(char c) {
+    static const Uint16 DIGITS[10] = {
+      0b111101101101111, 0b010110010010111, 0b110001010100111, 0b110001010001110, 0b101101111001001,
+      0b111100110001110, 0b011100111101111, 0b111001010010010, 0b111101111101111, 0b111101111001110
+    };
+    static const Uint16 LETTERS[26] = {
+      0b010101111101101, 0b110101110101110, 0b011100100100011, 0b110101101101110, 0b111100110100111,
+      0b111100110100100, 0b011100101101011, 0b101101111101101, 0b111010010010111, 0b001001001101010,
+      0b101101110101101, 0b100100100100111, 0b101111111101101, 0b110101101101101, 0b010101101101010,
+      0b110101110100100, 0b010101101110011, 0b110101110101101, 0b011100010001110, 0b111010010010010,
+      0b101101101101111, 0b101101101101010, 0b101101111111101, 0b101101010101101, 0b101101010010010,
+      0b111001010100111
+    };
+    if(c >= '0' && c <= '9') {
+      return DIGITS[c - '0'];
+    }
+    if(c >= 'A' && c <= 'Z') {
+      return LETTERS[c - 'A'];
+    }
+    if(c == '.') {
+      return 0b000000000000010;
+    }
+    if(c == ':') {
+      return 0b000010000010000;
+    }
+    return 0;
+  }
+
+  StatsOverlay::StatsOverlay() {
+    x = 8;
+    y = 8;
+    scale = 2;
+    budget = 1000.0f/60;
+  }
+
+  void StatsOverlay::setPosition(int x, int y) {
+    this->x = x;
+    this->y = y;
+  }
+
+  void StatsOverlay::setScale(int scale) {
+    this->scale = scale < 1 ? 1 : scale;
+  }
+
+  void StatsOverlay::setBudget(float budget) {
+    this->budget = budget;
+  }
+
+  void StatsOverlay::addText(const char* string, int x, int y) {
+    for(; *string != '\0'; string++, x += 4*scale) {
+      Uint16 glyph = getGlyph(*string);
+      for(int bit = 0; bit < 15; bit++) {
+        if(glyph & (1 << (14 - bit))) {
+          text.push_back({x + bit%3*scale, y + bit/3*scale, scale, scale});
+        }
+      }
+    }
+  }
+
+  void StatsOverlay::draw(SDL_Renderer* renderer, FrameStatsRing* stats) {
+    stats->copy(&frames);
+    panel.clear();
+    bars.clear();
+    slowBars.clear();
+    text.clear();
+
+    int width = GRAPH_FRAMES*scale;
+    int height = (GRAPH_HEIGHT + LINES*LINE_HEIGHT + 2)*scale;
+    panel.push_back({x, y, width + 2*scale, height});
+
+    // Newest frame on the right
+    int graphX = x + scale;
+    int graphBottom = y + (GRAPH_HEIGHT + 1)*scale;
+    int first = (int)frames.size() > GRAPH_FRAMES ? frames.size() - GRAPH_FRAMES : 0;
+    for(int i = first; i < (int)frames.size(); i++) {
+      float time = frames[i].frameTime;
+      int h = time/(2*budget)*GRAPH_HEIGHT;
+      if(h > GRAPH_HEIGHT) {
+        h = GRAPH_HEIGHT;
+      }
+      if(h < 1) {
+        h = 1;
+      }
+      SDL_Rect bar = {graphX + (GRAPH_FRAMES - ((int)frames.size() - i))*scale, graphBottom - h*scale, scale, h*scale};
+      (time > budget ? slowBars : bars).push_back(bar);
+    }
+    text.push_back({graphX, graphBottom - GRAPH_HEIGHT/2*scale, width, 1});
+
+    FrameStats last = frames.empty() ? FrameStats() : frames.back();
+    char line[64];
+    int lineY = graphBottom + 2*scale;
+    snprintf(line, sizeof(line), "FRAME %.1f P99 %.1f", last.frameTime, stats->getFrameTimePercentile(99));
+    addText(line, graphX, lineY);
+    lineY += LINE_HEIGHT*scale;
+    snprintf(line, sizeof(line), "UPDATE %.1f RENDER %.1f", last.updateTime, last.renderTime);
+    addText(line, graphX, lineY);
+    lineY += LINE_HEIGHT*scale;
+    snprintf(line, sizeof(line), "DRAWS %d BINDS %d RT %d", last.drawCalls, last.textureBinds, last.targetSwitches);
+    addText(line, graphX, lineY);
+    lineY += LINE_HEIGHT*scale;
+    snprintf(line, sizeof(line), "DRAWN %d CULLED %d", last.drawn, last.culled);
+    addText(line, graphX, lineY);
+    lineY += LINE_HEIGHT*scale;
+    snprintf(line, sizeof(line), "TEXTURES %.1f MB", last.textureMemory/(1024.0*1024.0));
+    addText(line, graphX, lineY);
+
+    SDL_BlendMode blendMode;
+    SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+    SDL_RenderFillRects(renderer, panel.data(), panel.size());
+    SDL_SetRenderDrawColor(renderer, 80, 200, 80, 255);
+    SDL_RenderFillRects(renderer, bars.data(), bars.size());
+    SDL_SetRenderDrawColor(renderer, 230, 60, 60, 255);
+    SDL_RenderFillRects(renderer, slowBars.data(), slowBars.size());
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderFillRects(renderer, text.data(), text.size());
+    SDL_SetRenderDrawBlendMode(renderer, blendMode);
+  }
+}
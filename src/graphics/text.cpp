@@ -29,6 +29,7 @@
  */
 
 #include "graphics/text.h"
+#include "graphics/texture.h"
 
 namespace blackhole::graphics {
   Text::Text(const char* file, const char* text, SDL_Renderer* renderer, int size, SDL_Color color, float x, float y) {
@@ -40,25 +41,31 @@ namespace blackhole::graphics {
     }
     
     SDL_Surface* surface = TTF_RenderText_Solid(font, text, color);
-    this->texture = SDL_CreateTextureFromSurface(renderer, surface);
+    this->texture = createTextureFromSurface(renderer, surface);
 
     SDL_FreeSurface(surface);
-    SDL_QueryTexture(this->texture, NULL, NULL, &destRect.w, &destRect.h);
-
-    this->x = x;
-    this->y = y;
+    queryTexture(this->texture, NULL, NULL, &destRect.w, &destRect.h);
+
+    record.texture = texture;
+    record.dest.w = destRect.w;
+    record.dest.h = destRect.h;
+    setCustomDraw(false);
+    setX(x);
+    setY(y);
   }
 
   Text::~Text() {
-    SDL_DestroyTexture(texture);
+    releaseTexture(texture);
   }
 
   void Text::setX(float x) {
     this->x = x;
+    record.dest.x = x;
   }
 
   void Text::setY(float y) {
     this->y = y;
+    record.dest.y = y;
   }
   
   float Text::getX() {
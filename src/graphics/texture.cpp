@@ -0,0 +1,214 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file texture.cpp
+ *
+ * A blackhole library set of functions creating textures, with or without a renderer
+ */
+
+#include "graphics/texture.h"
+#include "graphics/flight_recorder.h"
+#include "graphics/frame_pipeline.h"
+#include "graphics/world.h"
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace blackhole::graphics {
+
+  struct TextureStub {
+    // SDL checks the first field of a texture against its own magic
+    // pointer, so NULL makes SDL reject a stub that reaches it
+    const void* magic;
+    Uint32 format;
+    int access;
+    int w;
+    int h;
+  };
+
+  struct TrackedTexture {
+    Uint64 bytes;
+    SDL_Renderer* renderer;
+    World* world;
+  };
+
+  // Assets may be loaded from any thread
+  static std::mutex textureMutex;
+  static std::unordered_set<SDL_Texture*> stubs;
+  static std::unordered_map<SDL_Texture*, TrackedTexture> textureSizes;
+  static std::unordered_map<SDL_Renderer*, FramePipeline*> pipelines;
+  static Uint64 textureMemory = 0;
+  // Textures made without a current World are only in the total
+  static std::unordered_map<World*, Uint64> worldMemory;
+
+  static SDL_Texture* track(SDL_Texture* texture, SDL_Renderer* renderer, Uint32 format, int w, int h) {
+    if(texture == NULL) {
+      return NULL;
+    }
+    // Formats without a size per pixel are counted as 32 bit
+    Uint64 bytes = SDL_BYTESPERPIXEL(format);
+    if(bytes == 0) {
+      bytes = 4;
+    }
+    bytes *= (Uint64)w * h;
+    World* world = World::getCurrent();
+    std::lock_guard<std::mutex> lock(textureMutex);
+    textureSizes[texture] = {bytes, renderer, world};
+    textureMemory += bytes;
+    if(world != NULL) {
+      worldMemory[world] += bytes;
+    }
+    return texture;
+  }
+
+  static TextureStub* getStub(SDL_Texture* texture) {
+    std::lock_guard<std::mutex> lock(textureMutex);
+    return stubs.count(texture) != 0 ? (TextureStub*)texture : NULL;
+  }
+
+  SDL_Texture* createTexture(SDL_Renderer* renderer, Uint32 format, int access, int w, int h) {
+    FlightScope scope("create texture");
+    if(renderer != NULL) {
+      return track(SDL_CreateTexture(renderer, format, access, w, h), renderer, format, w, h);
+    }
+    SDL_Texture* texture = (SDL_Texture*)new TextureStub{NULL, format, access, w, h};
+    {
+      std::lock_guard<std::mutex> lock(textureMutex);
+      stubs.insert(texture);
+    }
+    return track(texture, NULL, format, w, h);
+  }
+
+  SDL_Texture* createTextureFromSurface(SDL_Renderer* renderer, SDL_Surface* surface) {
+    if(renderer != NULL || surface == NULL) {
+      FlightScope scope("create texture");
+      SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+      Uint32 format = SDL_PIXELFORMAT_UNKNOWN;
+      int w = 0;
+      int h = 0;
+      if(texture != NULL) {
+        SDL_QueryTexture(texture, &format, NULL, &w, &h);
+      }
+      return track(texture, renderer, format, w, h);
+    }
+    return createTexture(NULL, surface->format != NULL ? surface->format->format : SDL_PIXELFORMAT_UNKNOWN,
+                         SDL_TEXTUREACCESS_STATIC, surface->w, surface->h);
+  }
+
+  int queryTexture(SDL_Texture* texture, Uint32* format, int* access, int* w, int* h) {
+    TextureStub* stub = getStub(texture);
+    if(stub == NULL) {
+      return SDL_QueryTexture(texture, format, access, w, h);
+    }
+    if(format != NULL) {
+      *format = stub->format;
+    }
+    if(access != NULL) {
+      *access = stub->access;
+    }
+    if(w != NULL) {
+      *w = stub->w;
+    }
+    if(h != NULL) {
+      *h = stub->h;
+    }
+    return 0;
+  }
+
+  void destroyTexture(SDL_Texture* texture) {
+    {
+      std::lock_guard<std::mutex> lock(textureMutex);
+      auto size = textureSizes.find(texture);
+      if(size != textureSizes.end()) {
+        textureMemory -= size->second.bytes;
+        if(size->second.world != NULL) {
+          worldMemory[size->second.world] -= size->second.bytes;
+        }
+        textureSizes.erase(size);
+      }
+      if(stubs.erase(texture) != 0) {
+        delete (TextureStub*)texture;
+        return;
+      }
+    }
+    SDL_DestroyTexture(texture);
+  }
+
+  void releaseTexture(SDL_Texture* texture) {
+    {
+      // The lock is held so the pipeline can not be unset and emptied
+      // before the texture is added to it
+      std::lock_guard<std::mutex> lock(textureMutex);
+      auto size = textureSizes.find(texture);
+      if(size != textureSizes.end()) {
+        auto pipeline = pipelines.find(size->second.renderer);
+        if(pipeline != pipelines.end()) {
+          pipeline->second->releaseTexture(texture);
+          return;
+        }
+      }
+    }
+    destroyTexture(texture);
+  }
+
+  void setTexturePipeline(SDL_Renderer* renderer, FramePipeline* pipeline) {
+    std::lock_guard<std::mutex> lock(textureMutex);
+    if(pipeline != NULL) {
+      pipelines[renderer] = pipeline;
+    }
+    else {
+      pipelines.erase(renderer);
+    }
+  }
+
+  bool isTextureStub(SDL_Texture* texture) {
+    return getStub(texture) != NULL;
+  }
+
+  Uint64 getTextureMemory() {
+    std::lock_guard<std::mutex> lock(textureMutex);
+    return textureMemory;
+  }
+
+  Uint64 getTextureMemory(World* world) {
+    std::lock_guard<std::mutex> lock(textureMutex);
+    auto memory = worldMemory.find(world);
+    return memory != worldMemory.end() ? memory->second : 0;
+  }
+
+  void forgetTextureWorld(World* world) {
+    // Textures outliving their World stay in the total, but must not
+    // count for a new World made at the same address
+    std::lock_guard<std::mutex> lock(textureMutex);
+    if(worldMemory.erase(world) == 0) {
+      return;
+    }
+    for(auto& size : textureSizes) {
+      if(size.second.world == world) {
+        size.second.world = NULL;
+      }
+    }
+  }
+}
@@ -29,6 +29,8 @@
  */
 
 #include "graphics/tilemap.h"
+#include "graphics/texture.h"
+#include "graphics/flight_recorder.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -37,6 +39,7 @@
 namespace blackhole::graphics {
   
   Tilemap::Tilemap(const char* file, SDL_Renderer* renderer) {
+    FlightScope scope("bake tilemap", file);
     map = new Tmx::Map();
     map->ParseFile(file);
     
@@ -60,13 +63,13 @@ namespace blackhole::graphics {
     for(int i = 0; i < map->GetNumTileLayers(); i++) {
 
       const Tmx::TileLayer* layer = map->GetTileLayer(i);
-      SDL_Texture* texture = SDL_CreateTexture(renderer,
-					       SDL_PIXELFORMAT_RGBA8888,
-					       SDL_TEXTUREACCESS_TARGET,
-					       map->GetWidth()*
-					       map->GetTileWidth(),
-					       map->GetHeight()*
-					       map->GetTileHeight());
+      SDL_Texture* texture = createTexture(renderer,
+					   SDL_PIXELFORMAT_RGBA8888,
+					   SDL_TEXTUREACCESS_TARGET,
+					   map->GetWidth()*
+					   map->GetTileWidth(),
+					   map->GetHeight()*
+					   map->GetTileHeight());
       SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
       tileLayers[i] = new Image("/home/looking/c_testing/asdf.png", renderer, layer->GetX(), layer->GetY());
       
@@ -82,7 +85,7 @@ namespace blackhole::graphics {
 	    continue;
 	  }
 	  
-	  tilesets[tileset_id]->setFrame(layer->GetTileId(x, y));
+	  SDL_Rect srcrect = tilesets[tileset_id]->getFrameRect(layer->GetTileId(x, y));
 	  destrect = {
 	    x*map->GetTileset(tileset_id)->GetTileWidth(),
 	    y*map->GetTileset(tileset_id)->GetTileHeight(),
@@ -90,7 +93,7 @@ namespace blackhole::graphics {
 	    map->GetTileset(tileset_id)->GetTileHeight()
 	  };
 	  SDL_RenderCopy(renderer, tilesets[tileset_id]->getTexture(),
-			 tilesets[tileset_id]->getSrcRect(), &destrect);
+			 &srcrect, &destrect);
 	}
       }
       SDL_SetRenderTarget(renderer, NULL);
@@ -0,0 +1,184 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file transform.cpp
+ *
+ * A blackhole library class for attaching images to each other
+ */
+
+#include "graphics/transform.h"
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+
+namespace blackhole::graphics {
+
+  TransformNode::TransformNode(float x, float y, float rotation, float scaleX, float scaleY) {
+    this->x = x;
+    this->y = y;
+    this->rotation = rotation;
+    this->scaleX = scaleX;
+    this->scaleY = scaleY;
+    this->parent = NULL;
+    this->dirty = true;
+    this->version = 0;
+  }
+
+  TransformNode::~TransformNode() {
+    setParent(NULL);
+    for(TransformNode* child : children) {
+      child->parent = NULL;
+      child->markDirty();
+    }
+  }
+
+  void TransformNode::markDirty() {
+    // A dirty node always has dirty children, so stop at the first one
+    if(dirty) {
+      return;
+    }
+    dirty = true;
+    for(TransformNode* child : children) {
+      child->markDirty();
+    }
+  }
+
+  void TransformNode::setX(float x) {
+    this->x = x;
+    markDirty();
+  }
+
+  void TransformNode::setY(float y) {
+    this->y = y;
+    markDirty();
+  }
+
+  void TransformNode::setPosition(float x, float y) {
+    this->x = x;
+    this->y = y;
+    markDirty();
+  }
+
+  void TransformNode::setRotation(float rotation) {
+    this->rotation = rotation;
+    markDirty();
+  }
+
+  void TransformNode::setScale(float scaleX, float scaleY) {
+    this->scaleX = scaleX;
+    this->scaleY = scaleY;
+    markDirty();
+  }
+
+  float TransformNode::getX() {
+    return x;
+  }
+
+  float TransformNode::getY() {
+    return y;
+  }
+
+  float TransformNode::getRotation() {
+    return rotation;
+  }
+
+  float TransformNode::getScaleX() {
+    return scaleX;
+  }
+
+  float TransformNode::getScaleY() {
+    return scaleY;
+  }
+
+  void TransformNode::setParent(TransformNode* parent) {
+    if(parent == this->parent) {
+      return;
+    }
+    for(TransformNode* node = parent; node != NULL; node = node->parent) {
+      if(node == this) {
+        printf("TransformNode can not be its own parent\n");
+        return;
+      }
+    }
+    if(this->parent != NULL) {
+      std::vector<TransformNode*>& siblings = this->parent->children;
+      siblings.erase(std::find(siblings.begin(), siblings.end(), this));
+    }
+    this->parent = parent;
+    if(parent != NULL) {
+      parent->children.push_back(this);
+    }
+    markDirty();
+  }
+
+  TransformNode* TransformNode::getParent() {
+    return parent;
+  }
+
+  const WorldTransform* TransformNode::getWorld() {
+    if(!dirty) {
+      return &world;
+    }
+    float radians = rotation * (float)M_PI / 180.0f;
+    float cosine = cosf(radians);
+    float sine = sinf(radians);
+    WorldTransform local = {
+      cosine * scaleX, sine * scaleX,
+      -sine * scaleY, cosine * scaleY,
+      x, y,
+      rotation, scaleX, scaleY
+    };
+
+    if(parent == NULL) {
+      world = local;
+    }
+    else {
+      const WorldTransform* p = parent->getWorld();
+      world = {
+        p->a * local.a + p->c * local.b,
+        p->b * local.a + p->d * local.b,
+        p->a * local.c + p->c * local.d,
+        p->b * local.c + p->d * local.d,
+        p->a * local.x + p->c * local.y + p->x,
+        p->b * local.x + p->d * local.y + p->y,
+        p->rotation + local.rotation,
+        p->scaleX * local.scaleX,
+        p->scaleY * local.scaleY
+      };
+    }
+    dirty = false;
+    version++;
+    return &world;
+  }
+
+  SDL_FPoint TransformNode::apply(float x, float y) {
+    const WorldTransform* w = getWorld();
+    return {w->a * x + w->c * y + w->x, w->b * x + w->d * y + w->y};
+  }
+
+  Uint32 TransformNode::getVersion() {
+    return version;
+  }
+}
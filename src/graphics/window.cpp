@@ -29,34 +29,55 @@
  */
 
 #include "graphics/window.h"
-#include <SDL2/SDL_ttf.h>
+#include "graphics/animation_system.h"
+#include "graphics/render_cache.h"
+#include "graphics/camera.h"
+#include "graphics/transform.h"
+#include "graphics/texture.h"
+#include "graphics/flight_recorder.h"
+#include "jobs/thread_pool.h"
+#include "ecs/systems.h"
+#include <algorithm>
 
 namespace blackhole::graphics {
 
-  bool compare_position(const ImageHolder& first, const ImageHolder& second);
-  bool cam_sort(const CameraHolder& first, const CameraHolder& second);
   void renderThreadLoop(Window* window);
   //void eventThreadLoop(Window* window);
 
-  time_t getTime();
+  static time_t getTime();
+
+  // Images per task when culling and recording draws
+  const int DRAW_CHUNK_SIZE = 256;
+
+  // Milliseconds the render thread waits for a simulated frame
+  const int FRAME_WAIT = 100;
+
+  // The highest layer, entities are drawn after every ImageBase
+  const int ENTITY_LAYER = 32767;
   
-  Window::Window(int width, int height, const char* title, SDL_Rect renderFrame) {
+  Window::Window(int width, int height, const char* title, SDL_Rect renderFrame, bool headless) {
     this->width = width;
     this->height = height;
     this->title = title;
     this->bg_color = { 0xFF, 0xFF, 0xFF, 0xFF };
     this->renderFrame = renderFrame;
+    this->headless = headless;
+    // Assets made on this thread after the window animate in its World
+    world.makeCurrent();
 	
     init();
 	
   }
 
-  Window::Window(int width, int height, const char* title, SDL_Rect renderFrame, Color bg) {
+  Window::Window(int width, int height, const char* title, SDL_Rect renderFrame, Color bg, bool headless) {
     this->width = width;
     this->height = height;
     this->title = title;
     this->bg_color = bg;
     this->renderFrame = renderFrame;
+    this->headless = headless;
+    // Assets made on this thread after the window animate in its World
+    world.makeCurrent();
     
     init();
   }
@@ -64,18 +85,51 @@ namespace blackhole::graphics {
 
   Window::~Window() {
     this->running = false;
-    this->renderThread.join();
+    pipeline.close();
+    dispatcher.stop();
+    if(this->renderThread.joinable()) {
+      this->renderThread.join();
+    }
     //this->eventThread.join();
-    SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
-    SDL_Quit();
+    if(renderer != NULL) {
+      // No frame is drawn again, so released textures go straight away
+      setTexturePipeline(renderer, NULL);
+      pipeline.destroyReleased();
+    }
+    for(auto cache = staticLayers.begin(); cache != staticLayers.end(); ++cache) {
+      delete cache->second;
+    }
+    for(auto cache = collators.begin(); cache != collators.end(); ++cache) {
+      delete cache->second.cache;
+    }
+    delete graph;
+    delete targetPool;
+    if(renderer != NULL) {
+      SDL_DestroyRenderer(renderer);
+    }
+    if(window != NULL) {
+      SDL_DestroyWindow(window);
+    }
+    delete context;
   }
   
   bool Window::init() {
-    if(SDL_Init(SDL_INIT_VIDEO) < 0) {
-      printf("Failed to Initialize SDL2\n");
+    this->window = NULL;
+    this->renderer = NULL;
+    // Tags the events of this window in the FlightRecorder
+    static std::atomic<Uint32> nextInstance{1};
+    instance = nextInstance++;
+    // SDL is shared by every Window in the process
+    context = new Context(headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO);
+    if(!context->isValid()) {
       return false;
     }
+    if(headless) {
+      // No video driver is needed and assets given the NULL renderer get
+      // stub textures. The event queue is left to windows with a display
+      // as headless ones may run on many threads
+      return true;
+    }
 	
     this->window = SDL_CreateWindow(this->title,
 				    SDL_WINDOWPOS_CENTERED,
@@ -95,13 +149,24 @@ namespace blackhole::graphics {
       return false;
     }
     
-    preRenderer = SDL_CreateTexture(renderer,
-				    SDL_PIXELFORMAT_RGBX8888,
-				    SDL_TEXTUREACCESS_TARGET,
-				    renderFrame.w,
-				    renderFrame.h);
-
-    TTF_Init();
+    // Textures the simulation lets go of may still be drawn by frames in
+    // flight, so the render thread destroys them
+    setTexturePipeline(renderer, &pipeline);
+    targetPool = new RenderTargetPool(renderer);
+    graph = new RenderGraph(renderer, targetPool);
+
+    // Keyboard and mouse events are queued for the main loop as soon as
+    // the render thread pumps them. Other events are only queued if
+    // something subscribed to them
+    dispatcher.subscribe(SDL_WINDOWEVENT, [this](SDL_Event* event, float deltaTime) {
+      if(event->window.event == SDL_WINDOWEVENT_CLOSE) {
+	closed = true;
+      }
+    });
+    dispatcher.subscribe(SDL_QUIT, [this](SDL_Event* event, float deltaTime) {
+      closed = true;
+    });
+    dispatcher.start();
     
     return true;
 
@@ -110,59 +175,329 @@ namespace blackhole::graphics {
 
   // Rendering Function
   
+  void Window::recordFrame(Frame* frame) {
+    frame->staticLayers.assign(staticLayerIds.begin(), staticLayerIds.end());
+    frame->renderFrame = renderFrame;
+    frame->cameras.clear();
+    frame->viewports.clear();
+    std::list<CameraHolder>& cameraQueue = world.getCameras();
+    for(auto cam = cameraQueue.begin(); cam != cameraQueue.end(); ++cam) {
+      SDL_Rect* src = cam->cam->getSrcRect();
+      frame->cameras.push_back({
+	  {cam->cam->getX(), cam->cam->getY()},
+	  *cam->cam->getDestRect(),
+	  src != NULL ? *src : SDL_Rect{0, 0, 0, 0},
+	  src != NULL,
+	  cam->cam->getRendererFlip()
+	});
+      frame->viewports.push_back(*cam->cam->getViewport());
+    }
+
+    // Static layers are recorded whole for the render thread to cache,
+    // every other image is only collected here and then culled and
+    // recorded across the pool
+    while(frame->staticCommands.size() < frame->staticLayers.size()) {
+      frame->staticCommands.push_back(std::unique_ptr<RenderCommandBuffer>(new RenderCommandBuffer()));
+    }
+    for(auto& commands : frame->staticCommands) {
+      commands->clear();
+    }
+    frame->collators.clear();
+    drawItems.clear();
+    drawChunks.clear();
+    std::list<ImageHolder>& renderQueue = world.getImages();
+    for(auto image = renderQueue.begin(); image != renderQueue.end(); ++image) {
+      int layer = image->image->getLayer();
+      SpriteRecord* record = image->record;
+      // A Camera added as an image keeps its own cache, even on a static
+      // layer
+      Camera* collator = record->custom != NULL ? dynamic_cast<Camera*>(record->custom) : NULL;
+      auto staticLayer = std::lower_bound(frame->staticLayers.begin(), frame->staticLayers.end(), layer);
+      if(collator == NULL && staticLayer != frame->staticLayers.end() && *staticLayer == layer) {
+	frame->staticCommands[staticLayer - frame->staticLayers.begin()]->add(record, layer);
+	continue;
+      }
+      if(record->transform != NULL) {
+	// Parents are shared between images so their world transforms
+	// are worked out before the workers read them
+	record->transform->getWorld();
+      }
+      if(record->animation != NULL) {
+	// So are animation slots, e.g. an AnimatorController and the
+	// Animation it is playing, so the workers only read them
+	record->animation->evaluate(record->animationSlot);
+      }
+      // Custom records call the image's own functions so they get a
+      // chunk each and are recorded here rather than on the workers
+      int index = drawItems.size();
+      drawItems.push_back({record, layer});
+      if(record->custom != NULL) {
+	drawChunks.push_back({index, index + 1, true, collator});
+      }
+      else if(drawChunks.empty() || drawChunks.back().custom || drawChunks.back().end - drawChunks.back().begin == DRAW_CHUNK_SIZE) {
+	drawChunks.push_back({index, index + 1, false, NULL});
+      }
+      else {
+	drawChunks.back().end++;
+      }
+    }
+
+    // Draws are recorded into a buffer per chunk then joined in queue
+    // order, to be sorted and submitted by the render thread
+    int chunks = drawChunks.size();
+    while((int)chunkCommands.size() < chunks) {
+      chunkCommands.push_back(std::unique_ptr<RenderCommandBuffer>(new RenderCommandBuffer()));
+    }
+    jobs::ThreadPool::getDefault()->parallelFor(chunks, 1, [this, frame](int begin, int end) {
+      for(int chunk = begin; chunk < end; chunk++) {
+	if(!drawChunks[chunk].custom) {
+	  recordDrawItems(frame, drawChunks[chunk], chunkCommands[chunk].get());
+	}
+      }
+    });
+    frame->commands.clear();
+    frame->commands.setSortByTexture(sortByTexture);
+    for(int chunk = 0; chunk < chunks; chunk++) {
+      if(drawChunks[chunk].collator != NULL) {
+	recordCollator(frame, drawChunks[chunk].collator, drawItems[drawChunks[chunk].begin].layer);
+      }
+      else if(drawChunks[chunk].custom) {
+	recordDrawItems(frame, drawChunks[chunk], &frame->commands);
+      }
+      else {
+	frame->commands.append(chunkCommands[chunk].get());
+      }
+    }
+    frame->stats.drawn = frame->commands.getCount();
+    frame->stats.culled = drawItems.size() - frame->stats.drawn;
+
+    std::list<ecs::Registry*>& registries = world.getRegistries();
+    for(auto registry = registries.begin(); registry != registries.end(); ++registry) {
+      if(!frame->viewports.empty()) {
+	ecs::recordRenderables(*registry, &frame->commands, ENTITY_LAYER, frame->viewports.data(), frame->viewports.size(), &frame->stats);
+      }
+    }
+  }
+
+  void Window::recordDrawItems(Frame* frame, const DrawChunk& chunk, RenderCommandBuffer* buffer) {
+    // Animated records take their rects from the slot when they are
+    // added so images that are culled cost nothing
+    for(int i = chunk.begin; i < chunk.end; i++) {
+      DrawItem& item = drawItems[i];
+      SDL_Rect* destRect = getRecordDestRect(item.record);
+      for(const SDL_Rect& viewport : frame->viewports) {
+	if(SDL_HasIntersection(&viewport, destRect)) {
+	  buffer->add(item.record, item.layer);
+	  break;
+	}
+      }
+    }
+  }
+
+  void Window::recordCollator(Frame* frame, Camera* camera, int layer) {
+    SDL_Rect* destRect = camera->getDestRect();
+    bool visible = false;
+    for(const SDL_Rect& viewport : frame->viewports) {
+      visible = visible || SDL_HasIntersection(&viewport, destRect);
+    }
+    if(!visible) {
+      return;
+    }
+    // The images are recorded into a buffer of their own for the render
+    // thread to cache, and the frame gets a copy of the cache without a
+    // texture until the cache is drawn
+    int index = frame->collators.size();
+    if(index == (int)frame->collatorCommands.size()) {
+      frame->collatorCommands.push_back(std::unique_ptr<RenderCommandBuffer>(new RenderCommandBuffer()));
+    }
+    frame->collatorCommands[index]->clear();
+    camera->recordImages(frame->collatorCommands[index].get());
+    frame->collators.push_back({camera->getId(), {destRect->w, destRect->h}, frame->commands.getCount()});
+    SDL_FRect dest = {(float)destRect->x, (float)destRect->y, (float)destRect->w, (float)destRect->h};
+    frame->commands.addTexture(NULL, camera->getSrcRect(), &dest, layer, camera->getRendererFlip());
+  }
+
+  void Window::updateCollators(Frame* frame) {
+    // Caches of cameras no longer drawn are dropped, so a Camera can be
+    // deleted while frames that drew it are still in flight
+    for(auto cache = collators.begin(); cache != collators.end();) {
+      bool drawn = false;
+      for(const FrameCollator& collator : frame->collators) {
+	drawn = drawn || collator.id == cache->first;
+      }
+      if(drawn) {
+	++cache;
+	continue;
+      }
+      delete cache->second.cache;
+      cache = collators.erase(cache);
+    }
+    for(size_t i = 0; i < frame->collators.size(); i++) {
+      const FrameCollator& collator = frame->collators[i];
+      CollatorCache& cache = collators[collator.id];
+      if(cache.cache != NULL && (cache.size.x != collator.size.x || cache.size.y != collator.size.y)) {
+	delete cache.cache;
+	cache.cache = NULL;
+      }
+      if(cache.cache == NULL) {
+	cache.cache = new RenderCache(renderer, collator.size.x, collator.size.y);
+	cache.size = collator.size;
+      }
+      cache.cache->update(frame->collatorCommands[i].get());
+      frame->commands.setTexture(collator.command, cache.cache->getTexture());
+    }
+  }
+
+  void Window::updateStaticLayers(Frame* frame) {
+    // Only the render thread touches the caches, so changes from the
+    // simulation arrive with the frame they were made before
+    if(staticLayerSize.x != frame->renderFrame.w || staticLayerSize.y != frame->renderFrame.h) {
+      // Static layers cache the whole frame so they follow its size
+      for(auto cache = staticLayers.begin(); cache != staticLayers.end(); ++cache) {
+	delete cache->second;
+      }
+      staticLayers.clear();
+      staticLayerSize = {frame->renderFrame.w, frame->renderFrame.h};
+    }
+    for(auto cache = staticLayers.begin(); cache != staticLayers.end();) {
+      if(std::binary_search(frame->staticLayers.begin(), frame->staticLayers.end(), cache->first)) {
+	++cache;
+	continue;
+      }
+      delete cache->second;
+      cache = staticLayers.erase(cache);
+    }
+    for(int layer : frame->staticLayers) {
+      if(staticLayers.count(layer) == 0) {
+	staticLayers[layer] = new RenderCache(renderer, staticLayerSize.x, staticLayerSize.y);
+      }
+    }
+  }
+
+  // Rendering Function
+  
+  void Window::renderWorld(Frame* frame) {
+    SDL_SetRenderDrawColor(renderer,
+			   bg_color.red,
+			   bg_color.green,
+			   bg_color.blue,
+			   bg_color.alpha);
+    SDL_RenderClear(renderer);
+
+    // Collators and static layers draw into their caches with the
+    // renderer so they are finished here. Commands sort by layer so the
+    // static layers still land in order
+    updateCollators(frame);
+    for(size_t i = 0; i < frame->staticLayers.size(); i++) {
+      int layer = frame->staticLayers[i];
+      RenderCache* cache = staticLayers[layer];
+      cache->update(frame->staticCommands[i].get());
+      SDL_FRect destRect = {0, 0, (float)frame->renderFrame.w, (float)frame->renderFrame.h};
+      frame->commands.addTexture(cache->getTexture(), NULL, &destRect, layer);
+    }
+    frame->commands.submit(renderer, &frame->stats);
+
+    // The flag keeps the lock off frames with no capture
+    if(capturePending.exchange(false)) {
+      std::string file;
+      {
+	std::lock_guard<std::mutex> lock(captureMutex);
+	file.swap(captureFile);
+      }
+      if(!file.empty()) {
+	frame->commands.save(file.c_str());
+      }
+    }
+  }
+
   void Window::Render() {
+    FlightRecorder* recorder = FlightRecorder::getDefault();
+    // Render targets and caches count as the World's texture memory
+    world.makeCurrent();
     time_t time;
     while(running) {
       time = getTime();
-      SDL_SetRenderDrawColor(renderer,
-			     bg_color.red,
-			     bg_color.green,
-			     bg_color.blue,
-			     bg_color.alpha);
-      SDL_RenderClear(renderer);
-      SDL_SetRenderTarget(renderer, preRenderer);
-      SDL_RenderClear(renderer);
-
-      for(auto image = renderQueue.begin(); image != renderQueue.end(); ++image) {
-	SDL_Rect destRect = *image->image->getDestRect();
-	for(auto cam = cameraQueue.begin(); cam != cameraQueue.end(); ++cam) {
-	  SDL_Rect viewport = *cam->cam->getViewport();
-	  
-	  if((viewport.x < destRect.x || viewport.w > destRect.x) &&
-	     (viewport.y < destRect.y || viewport.h > destRect.y)) {
-	    SDL_RenderCopyEx(renderer, image->image->getTexture(), image->image->getSrcRect(), &destRect, 0, NULL, image->image->getRendererFlip());
-	    break;
-	  }
-	  else if((viewport.x < destRect.x + destRect.w  ||
-	     viewport.w > destRect.x + destRect.w ) &&
-	     (viewport.y < destRect.y + destRect.h  ||
-	      viewport.h > destRect.y + destRect.h)) {
-	    SDL_RenderCopyEx(renderer, image->image->getTexture(), image->image->getSrcRect(), &destRect, 0, NULL, image->image->getRendererFlip());
-	    break;
-	  }
+      Uint64 phase = SDL_GetPerformanceCounter();
+
+      // Events are handled before drawing so input is not held back a
+      // whole frame
+      handleEvents(frameTime);
+      phase = recorder->record("events", phase);
+
+      // Draw the oldest frame the simulation has finished. Without one
+      // the window still handles its events
+      Frame* frame = pipeline.beginRead(FRAME_WAIT);
+      if(frame != NULL) {
+	FlightRecorder::setThreadFrame(instance, frame->index);
+	Uint64 renderStart = recorder->record("wait simulation", phase);
+	updateStaticLayers(frame);
+
+	// The passes are declared again every frame. Camera targets only
+	// live between their two passes so cameras of one size share one
+	RenderResource world = graph->createTarget(frame->renderFrame.w, frame->renderFrame.h, SDL_PIXELFORMAT_RGBX8888);
+	graph->addPass("clear", {}, BACKBUFFER, [this](SDL_Renderer* renderer, RenderGraph* graph) {
+	  SDL_SetRenderDrawColor(renderer,
+				 bg_color.red,
+				 bg_color.green,
+				 bg_color.blue,
+				 bg_color.alpha);
+	  SDL_RenderClear(renderer);
+	});
+	graph->addPass("world", {}, world, [this, frame](SDL_Renderer* renderer, RenderGraph* graph) {
+	  renderWorld(frame);
+	});
+	if(renderPasses != NULL) {
+	  world = renderPasses(graph, world);
 	}
-	image->image->addTime(frameTime);
-      }
 
-      for(auto cam = cameraQueue.begin(); cam  != cameraQueue.end(); ++cam) {
+	for(const FrameCamera& camera : frame->cameras) {
+	  RenderResource target = graph->createTarget(camera.dest.w, camera.dest.h, SDL_PIXELFORMAT_RGBX8888);
+
+	  // The world is shifted by the float view position so cameras
+	  // scroll smoothly at native resolution
+	  graph->addPass("camera", {world}, target, [frame, &camera, world](SDL_Renderer* renderer, RenderGraph* graph) {
+	    SDL_FRect destRect = {-camera.view.x, -camera.view.y, (float)frame->renderFrame.w, (float)frame->renderFrame.h};
+	    SDL_RenderClear(renderer);
+	    SDL_RenderCopyExF(renderer, graph->getTexture(world), NULL, &destRect, 0, NULL, camera.flip);
+	    frame->stats.drawCalls++;
+	    frame->stats.textureBinds++;
+	  });
+	  graph->addPass("present", {target}, BACKBUFFER, [frame, &camera, target](SDL_Renderer* renderer, RenderGraph* graph) {
+	    SDL_RenderCopy(renderer, graph->getTexture(target), camera.hasSrc ? &camera.src : NULL, &camera.dest);
+	    frame->stats.drawCalls++;
+	    frame->stats.textureBinds++;
+	  });
+	}
 
-	SDL_Rect destRect = *cam->cam->getViewport();
-	SDL_Rect camDestRect = *cam->cam->getDestRect();
-	SDL_QueryTexture(preRenderer, NULL, NULL, &destRect.w, &destRect.h);
-	
-	SDL_SetRenderTarget(renderer, cam->cam->getCamTexture());
-	SDL_RenderClear(renderer);
-	SDL_RenderCopyEx(renderer, preRenderer, NULL, &destRect, 0, NULL, cam->cam->getRendererFlip());
+	graph->execute();
+	phase = recorder->record("render", renderStart);
+	frame->stats.targetSwitches = graph->getTargetSwitches();
+	frame->stats.textureMemory = getTextureMemory(&this->world);
 
-	SDL_SetRenderTarget(renderer, NULL);
-	SDL_RenderCopy(renderer, cam->cam->getCamTexture(), cam->cam->getSrcRect(), &camDestRect);
-      }
+	// The overlay shows the frames before this one
+	if(showStats) {
+	  statsOverlay.setBudget(1000.0f/fps);
+	  statsOverlay.draw(renderer, &frameStats);
+	}
       
-      SDL_RenderPresent(renderer);
+	SDL_RenderPresent(renderer);
+	Uint64 presented = recorder->record("present", phase);
+	float frequency = SDL_GetPerformanceFrequency();
+	frame->stats.renderTime = (presented - renderStart)*1000.0f/frequency;
+	frame->stats.frameTime = lastPresent != 0 ? (presented - lastPresent)*1000.0f/frequency : 0;
+	lastPresent = presented;
+	frameStats.push(frame->stats);
+	FrameStats stats = frame->stats;
+	pipeline.endRead();
+
+	// A capture copies the recent events, so the frame is handed back first
+	recorder->endFrame(stats.index, stats.frameTime);
+      }
 
-      handleEvents(difftime(getTime(), time)/1000.0f);
-      
-      while(difftime(getTime(), time) < 1000.0/fps) {
+      // Pumping while waiting timestamps input as it happens,
+      // unless replaying, which runs uncapped
+      while(!replaying && difftime(getTime(), time) < 1000.0/fps) {
+	SDL_PumpEvents();
 	SDL_Delay(1);
       }
       frameTime = difftime(getTime(), time)/1000;
@@ -170,27 +505,48 @@ namespace blackhole::graphics {
   }
 
   void Window::addCamera(Camera* cam) {
-    CameraHolder camHolder = {
-      cam
-    };
-    cameraQueue.push_back(camHolder);
-    cameraQueue.sort(cam_sort);
+    world.addCamera(cam);
   }
   
   void Window::addImage(ImageBase* image) {
-    ImageHolder imageHolder = {
-      image
-    };
-    renderQueue.push_back(imageHolder);
-    renderQueue.sort(compare_position);
+    world.addImage(image);
   }
 
   void Window::removeImage(ImageBase* image) {
-    renderQueue.remove_if([image](const ImageHolder& value) {return value.image == image;});
+    world.removeImage(image);
+  }
+
+  void Window::addEmitter(ParticleEmitter* emitter) {
+    world.addEmitter(emitter);
+  }
+
+  void Window::removeEmitter(ParticleEmitter* emitter) {
+    world.removeEmitter(emitter);
+  }
+
+  void Window::setLayerStatic(int layer, bool isStatic) {
+    if(isStatic) {
+      staticLayerIds.insert(layer);
+    }
+    else {
+      staticLayerIds.erase(layer);
+    }
+  }
+
+  void Window::addRegistry(ecs::Registry* registry) {
+    world.addRegistry(registry);
+  }
+
+  void Window::removeRegistry(ecs::Registry* registry) {
+    world.removeRegistry(registry);
   }
 
   void Window::removeCamera(Camera* cam) {
-    cameraQueue.remove_if([cam](const CameraHolder& value) {return value.cam == cam;});
+    world.removeCamera(cam);
+  }
+
+  World* Window::getWorld() {
+    return &world;
   }
 
   void Window::setFps(int fps) {
@@ -222,13 +578,28 @@ namespace blackhole::graphics {
   void Window::setRenderFrame(int width, int height) {
     this->renderFrame.w = this->width > width ? this->width : width;
     this->renderFrame.h = this->height > height ? this->height : height;
+  }
 
-    SDL_DestroyTexture(preRenderer);
-    preRenderer = SDL_CreateTexture(renderer,
-				    SDL_PIXELFORMAT_RGBX8888,
-				    SDL_TEXTUREACCESS_TARGET,
-				    renderFrame.w,
-				    renderFrame.h); 
+  void Window::setTextureSorting(bool sortByTexture) {
+    this->sortByTexture = sortByTexture;
+  }
+
+  void Window::setMaxFramesInFlight(int maxFramesInFlight) {
+    pipeline.setMaxFramesInFlight(maxFramesInFlight);
+  }
+
+  float Window::getFrameLatency() {
+    return pipeline.getLatency();
+  }
+
+  void Window::captureFrame(const char* file) {
+    std::lock_guard<std::mutex> lock(captureMutex);
+    captureFile = file;
+    capturePending = true;
+  }
+
+  void Window::setRenderPasses(RenderResource (*renderPasses)(RenderGraph* graph, RenderResource world)) {
+    this->renderPasses = renderPasses;
   }
   
 
@@ -244,14 +615,74 @@ namespace blackhole::graphics {
   void Window::startMainLoop(int fps) {
     this->fps = fps;
     this->running = true;
-    this->renderThread = std::thread(renderThreadLoop, this);
+    world.makeCurrent();
+    if(!headless) {
+      this->renderThread = std::thread(renderThreadLoop, this);
+    }
     //this->eventThread = std::thread(eventThreadLoop, this);
+    FlightRecorder* recorder = FlightRecorder::getDefault();
     time_t timer;
     while(!isClosed()) {
       timer = getTime();
+      // A replayed tick takes its input, deltaTime and number from the
+      // log, so getTickSeed() gives the recorded values, ending with it
+      if(replaying && !inputLog.readTick(&input, &deltaTime, &tick)) {
+	replaying = false;
+	close();
+	break;
+      }
+      // Events are tagged with the frame the tick makes
+      FlightRecorder::setThreadFrame(instance, tick);
+      // Headless windows draw nothing so ticks run back to back with a
+      // fixed step. Otherwise this waits while the render thread is the
+      // maximum frames behind, so the simulation never runs further
+      // ahead than that
+      Uint64 phase = SDL_GetPerformanceCounter();
+      Frame* frame = NULL;
+      if(!headless) {
+	frame = pipeline.beginWrite();
+	if(frame == NULL) {
+	  break;
+	}
+	FlightRecorder::setThreadFrame(instance, frame->index);
+	phase = recorder->record("wait frame", phase);
+      }
+      Uint64 updateStart = phase;
+      if(!replaying) {
+	input.update();
+      }
+      if(inputLog.isRecording()) {
+	inputLog.writeTick(tick, deltaTime, input.getEvents());
+      }
+      phase = recorder->record("input", phase);
       if(_main != NULL) {
 	this->_main();
+	phase = recorder->record("main", phase);
+      }
+      if(updateJobs != NULL) {
+	updateJobs(&updateGraph, deltaTime);
+	updateGraph.execute();
+	phase = recorder->record("update jobs", phase);
       }
+      world.update(deltaTime);
+      phase = recorder->record("world update", phase);
+      tick++;
+      if(headless) {
+	// Nothing is rendered, so a frame is only its update
+	FrameStats stats = FrameStats();
+	stats.index = tick - 1;
+	stats.updateTime = (phase - updateStart)*1000.0f/SDL_GetPerformanceFrequency();
+	stats.frameTime = stats.updateTime;
+	stats.textureMemory = getTextureMemory(&world);
+	frameStats.push(stats);
+	recorder->endFrame(stats.index, stats.frameTime);
+	this->deltaTime = 1.0/fps;
+	continue;
+      }
+      recordFrame(frame);
+      phase = recorder->record("record frame", phase);
+      frame->stats.updateTime = (phase - updateStart)*1000.0f/SDL_GetPerformanceFrequency();
+      pipeline.endWrite();
       this->deltaTime = difftime(getTime(), timer)/1000.0;
     }
   }
@@ -260,29 +691,31 @@ namespace blackhole::graphics {
     this->_main = _main;
   }
 
+  void Window::setUpdateJobs(void (*updateJobs)(jobs::JobGraph* graph, float deltaTime)) {
+    this->updateJobs = updateJobs;
+  }
+
   void Window::setEventHandler(void (*_eventMain)(SDL_Event* event, float deltaTime)) {
-    this->_eventMain = _eventMain;
+    if(eventHandler != 0) {
+      dispatcher.unsubscribe(eventHandler);
+      eventHandler = 0;
+    }
+    if(_eventMain != NULL) {
+      eventHandler = dispatcher.subscribe(input::ALL_EVENTS, _eventMain);
+    }
+  }
+
+  input::EventDispatcher* Window::getEventDispatcher() {
+    return &dispatcher;
   }
   
   void Window::handleEvents(float deltaTime) {
     //while(running) {
       SDL_Event event;
       while(SDL_PollEvent(&event) && running) {
-	if(_eventMain != NULL) {
-	  _eventMain(&event, deltaTime);
-	}
-	switch(event.type) {
-	case SDL_WINDOWEVENT:
-		  
-	  switch(event.window.event) {
-	  case SDL_WINDOWEVENT_CLOSE:
-	    closed = true;
-	    return;
-	  }
-		  
-	  break;
-	}
+	dispatcher.dispatch(&event, deltaTime);
       }
+      dispatcher.flush(deltaTime);
       //}
   }
 
@@ -291,23 +724,81 @@ namespace blackhole::graphics {
     return closed;
   }
 
+  void Window::close() {
+    closed = true;
+  }
+
+  bool Window::isHeadless() {
+    return headless;
+  }
+
 
   double Window::getDeltaTime() {
     return deltaTime;
   }
   
   bool Window::keyDown(SDL_Scancode scancode) {
-    return keyboard_state[scancode];
+    return input.getSnapshot()->keyDown(scancode);
   }
-  
-  bool compare_position(const ImageHolder& first, const ImageHolder& second) {
-    return(first.image->getLayer() < second.image->getLayer());
+
+  bool Window::keyPressed(SDL_Scancode scancode) {
+    return input.getSnapshot()->keyPressed(scancode);
   }
 
-  bool cam_sort(const CameraHolder& first, const CameraHolder& second) {
-    return(first.cam->getLayer() < second.cam->getLayer());
+  bool Window::keyReleased(SDL_Scancode scancode) {
+    return input.getSnapshot()->keyReleased(scancode);
   }
 
+  input::Input* Window::getInput() {
+    return &input;
+  }
+
+  FrameStatsRing* Window::getFrameStats() {
+    return &frameStats;
+  }
+
+  void Window::setStatsOverlay(bool show) {
+    showStats = show;
+  }
+
+  bool Window::recordInput(const char* file) {
+    replaying = false;
+    return inputLog.record(file, seed);
+  }
+
+  bool Window::replayInput(const char* file) {
+    if(!inputLog.load(file)) {
+      return false;
+    }
+    seed = inputLog.getSeed();
+    replaying = true;
+    return true;
+  }
+
+  bool Window::isReplaying() {
+    return replaying;
+  }
+
+  void Window::setSeed(Uint64 seed) {
+    this->seed = seed;
+  }
+
+  Uint64 Window::getSeed() {
+    return seed;
+  }
+
+  Uint64 Window::getTick() {
+    return tick;
+  }
+
+  Uint64 Window::getTickSeed() {
+    // splitmix64
+    Uint64 z = seed + (tick + 1)*0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+  
   void renderThreadLoop(Window* window) {
     window->Render();
   }
@@ -317,7 +808,7 @@ namespace blackhole::graphics {
   // }
 
 
-  time_t getTime() {
+  static time_t getTime() {
     struct timeval time{};
     gettimeofday(&time, nullptr);
     time_t timer = (time.tv_sec * 1000) + (time.tv_usec / 1000);
@@ -0,0 +1,131 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file world.cpp
+ *
+ * A blackhole library class holding the state of one game instance
+ */
+
+#include "graphics/world.h"
+#include "graphics/particle_emitter.h"
+#include "graphics/flight_recorder.h"
+#include "graphics/texture.h"
+
+namespace blackhole::graphics {
+
+  static thread_local World* currentWorld = NULL;
+
+  // Also used by Camera, neither keeps any state
+  bool compare_position(const ImageHolder& first, const ImageHolder& second) {
+    return first.image->getLayer() < second.image->getLayer();
+  }
+
+  static bool cam_sort(const CameraHolder& first, const CameraHolder& second) {
+    return first.cam->getLayer() < second.cam->getLayer();
+  }
+
+  World::World() {
+  }
+
+  World::~World() {
+    if(currentWorld == this) {
+      currentWorld = NULL;
+    }
+    forgetTextureWorld(this);
+  }
+
+  void World::makeCurrent() {
+    currentWorld = this;
+  }
+
+  World* World::getCurrent() {
+    return currentWorld;
+  }
+
+  void World::addImage(ImageBase* image) {
+    // Sorting on every add makes bursts of adds slow
+    FlightScope scope("add image");
+    images.push_back({image, image->getRecord()});
+    images.sort(compare_position);
+  }
+
+  void World::removeImage(ImageBase* image) {
+    images.remove_if([image](const ImageHolder& value) {return value.image == image;});
+  }
+
+  void World::addEmitter(ParticleEmitter* emitter) {
+    emitters.push_back(emitter);
+    addImage(emitter);
+  }
+
+  void World::removeEmitter(ParticleEmitter* emitter) {
+    emitters.remove(emitter);
+    removeImage(emitter);
+  }
+
+  void World::addCamera(Camera* cam) {
+    cameras.push_back({cam});
+    cameras.sort(cam_sort);
+  }
+
+  void World::removeCamera(Camera* cam) {
+    cameras.remove_if([cam](const CameraHolder& value) {return value.cam == cam;});
+  }
+
+  void World::addRegistry(ecs::Registry* registry) {
+    registries.push_back(registry);
+  }
+
+  void World::removeRegistry(ecs::Registry* registry) {
+    registries.remove(registry);
+  }
+
+  std::list<ImageHolder>& World::getImages() {
+    return images;
+  }
+
+  std::list<CameraHolder>& World::getCameras() {
+    return cameras;
+  }
+
+  std::list<ecs::Registry*>& World::getRegistries() {
+    return registries;
+  }
+
+  AnimationSystem* World::getAnimationSystem() {
+    return &animations;
+  }
+
+  void World::update(float time) {
+    animations.update(time);
+    for(ParticleEmitter* emitter : emitters) {
+      emitter->update(time);
+    }
+  }
+
+  double World::getClock() {
+    return animations.getClock();
+  }
+}
@@ -0,0 +1,265 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file event_dispatcher.cpp
+ *
+ * A blackhole library class for sending SDL events to handlers by type
+ */
+
+#include "input/event_dispatcher.h"
+#include <algorithm>
+
+namespace blackhole::input {
+
+  // SDL has one event filter for the process, so every started
+  // dispatcher shares it. It keeps the types any of them wants, counted
+  // here so the filter never takes the lock of a dispatcher. Dispatchers
+  // take these locks inside their own and never the other way around.
+  // SDL calls the filter holding a lock SDL_SetEventFilter() takes, so
+  // the filter is installed under a lock of its own
+  static std::mutex filterMutex;
+  static std::unordered_map<Uint32, int> filterCounts;
+  static std::mutex installMutex;
+  static int filterUsers = 0;
+
+  static const Uint32 INPUT_EVENTS[] = {
+    SDL_KEYDOWN, SDL_KEYUP, SDL_MOUSEMOTION, SDL_MOUSEBUTTONDOWN, SDL_MOUSEBUTTONUP, SDL_MOUSEWHEEL
+  };
+
+  EventDispatcher::EventDispatcher(Input* input) {
+    this->input = input;
+    nextId = 1;
+    coalescing = false;
+    started = false;
+    removed = false;
+    hasMotion = false;
+    hasWheel = false;
+  }
+
+  EventDispatcher::~EventDispatcher() {
+    stop();
+  }
+
+  void EventDispatcher::start() {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    if(started) {
+      return;
+    }
+    started = true;
+    {
+      std::lock_guard<std::mutex> filterLock(filterMutex);
+      for(auto& count : counts) {
+        filterCounts[count.first] += count.second;
+      }
+      // Input is given its events as they are dispatched, so the filter
+      // keeps them even with nobody subscribed
+      if(input != NULL) {
+        for(Uint32 type : INPUT_EVENTS) {
+          filterCounts[type]++;
+        }
+      }
+    }
+    std::lock_guard<std::mutex> installLock(installMutex);
+    if(filterUsers++ == 0) {
+      SDL_SetEventFilter(filter, NULL);
+    }
+  }
+
+  void EventDispatcher::stop() {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    if(!started) {
+      return;
+    }
+    started = false;
+    {
+      std::lock_guard<std::mutex> filterLock(filterMutex);
+      for(auto& count : counts) {
+        filterCounts[count.first] -= count.second;
+      }
+      if(input != NULL) {
+        for(Uint32 type : INPUT_EVENTS) {
+          filterCounts[type]--;
+        }
+      }
+    }
+    // The filter stays while any other dispatcher is started
+    std::lock_guard<std::mutex> installLock(installMutex);
+    if(--filterUsers == 0) {
+      SDL_SetEventFilter(NULL, NULL);
+    }
+  }
+
+  int EventDispatcher::filter(void* userdata, SDL_Event* event) {
+    // Called by SDL on any thread pumping or pushing events, before they
+    // are queued
+    if(event->type == SDL_QUIT) {
+      return 1;
+    }
+    std::lock_guard<std::mutex> lock(filterMutex);
+    auto all = filterCounts.find(ALL_EVENTS);
+    if(all != filterCounts.end() && all->second > 0) {
+      return 1;
+    }
+    auto count = filterCounts.find(event->type);
+    return count != filterCounts.end() && count->second > 0;
+  }
+
+  void EventDispatcher::count(Uint32 type, int change) {
+    counts[type] += change;
+    if(started) {
+      std::lock_guard<std::mutex> lock(filterMutex);
+      filterCounts[type] += change;
+    }
+  }
+
+  int EventDispatcher::subscribe(Uint32 type, EventHandler handler) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    int id = nextId++;
+    subscribers[type].push_back({id, handler});
+    count(type, 1);
+    return id;
+  }
+
+  void EventDispatcher::unsubscribe(int id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    for(auto& table : subscribers) {
+      for(Subscriber& subscriber : table.second) {
+        if(subscriber.id == id) {
+          // Only cleared here as a handler may unsubscribe while its
+          // table is being walked, flush() removes it
+          subscriber.id = 0;
+          subscriber.handler = nullptr;
+          count(table.first, -1);
+          removed = true;
+          return;
+        }
+      }
+    }
+  }
+
+  void EventDispatcher::setCoalescing(bool coalescing) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    this->coalescing = coalescing;
+  }
+
+  bool EventDispatcher::isWanted(Uint32 type) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    auto all = counts.find(ALL_EVENTS);
+    if(all != counts.end() && all->second > 0) {
+      return true;
+    }
+    auto count = counts.find(type);
+    return count != counts.end() && count->second > 0;
+  }
+
+  void EventDispatcher::send(SDL_Event* event, float deltaTime) {
+    Uint32 types[2] = {event->type, ALL_EVENTS};
+    for(Uint32 type : types) {
+      auto table = subscribers.find(type);
+      if(table == subscribers.end()) {
+        continue;
+      }
+      std::vector<Subscriber>& list = table->second;
+      // By index as a handler may subscribe and grow the table
+      for(size_t i = 0; i < list.size(); i++) {
+        if(list[i].handler) {
+          EventHandler handler = list[i].handler;
+          handler(event, deltaTime);
+        }
+      }
+    }
+  }
+
+  void EventDispatcher::flushMotion(float deltaTime) {
+    if(hasMotion) {
+      hasMotion = false;
+      send(&motion, deltaTime);
+    }
+  }
+
+  void EventDispatcher::flushWheel(float deltaTime) {
+    if(hasWheel) {
+      hasWheel = false;
+      send(&wheel, deltaTime);
+    }
+  }
+
+  void EventDispatcher::dispatch(SDL_Event* event, float deltaTime) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    // Dispatching is on the thread polling events, the one producer the
+    // ring of Input allows. It sees every event, merged or not
+    if(input != NULL) {
+      input->push(event);
+    }
+    if(coalescing && event->type == SDL_MOUSEMOTION) {
+      if(hasMotion && motion.motion.windowID == event->motion.windowID && motion.motion.which == event->motion.which) {
+        int xrel = motion.motion.xrel + event->motion.xrel;
+        int yrel = motion.motion.yrel + event->motion.yrel;
+        motion = *event;
+        motion.motion.xrel = xrel;
+        motion.motion.yrel = yrel;
+        return;
+      }
+      flushMotion(deltaTime);
+      motion = *event;
+      hasMotion = true;
+      return;
+    }
+    if(coalescing && event->type == SDL_MOUSEWHEEL) {
+      if(hasWheel && wheel.wheel.windowID == event->wheel.windowID && wheel.wheel.which == event->wheel.which &&
+         wheel.wheel.direction == event->wheel.direction) {
+        wheel.common.timestamp = event->common.timestamp;
+        wheel.wheel.x += event->wheel.x;
+        wheel.wheel.y += event->wheel.y;
+        wheel.wheel.preciseX += event->wheel.preciseX;
+        wheel.wheel.preciseY += event->wheel.preciseY;
+        return;
+      }
+      flushWheel(deltaTime);
+      wheel = *event;
+      hasWheel = true;
+      return;
+    }
+    // Merged events go out first so handlers still see them in order
+    flushMotion(deltaTime);
+    flushWheel(deltaTime);
+    send(event, deltaTime);
+  }
+
+  void EventDispatcher::flush(float deltaTime) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    flushMotion(deltaTime);
+    flushWheel(deltaTime);
+    if(removed) {
+      removed = false;
+      for(auto& table : subscribers) {
+        std::vector<Subscriber>& list = table.second;
+        list.erase(std::remove_if(list.begin(), list.end(), [](const Subscriber& subscriber) {
+          return subscriber.id == 0;
+        }), list.end());
+      }
+    }
+  }
+}
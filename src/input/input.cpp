@@ -0,0 +1,190 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file input.cpp
+ *
+ * A blackhole library class for sampling keyboard and mouse input once per tick
+ */
+
+#include "input/input.h"
+#include <string.h>
+
+namespace blackhole::input {
+
+  bool InputSnapshot::keyDown(SDL_Scancode scancode) const {
+    return scancode >= 0 && scancode < SDL_NUM_SCANCODES && (keys[scancode] & INPUT_HELD);
+  }
+
+  bool InputSnapshot::keyPressed(SDL_Scancode scancode) const {
+    return scancode >= 0 && scancode < SDL_NUM_SCANCODES && (keys[scancode] & INPUT_PRESSED);
+  }
+
+  bool InputSnapshot::keyReleased(SDL_Scancode scancode) const {
+    return scancode >= 0 && scancode < SDL_NUM_SCANCODES && (keys[scancode] & INPUT_RELEASED);
+  }
+
+  bool InputSnapshot::buttonDown(int button) const {
+    return button >= 0 && button < 8 && (buttons[button] & INPUT_HELD);
+  }
+
+  bool InputSnapshot::buttonPressed(int button) const {
+    return button >= 0 && button < 8 && (buttons[button] & INPUT_PRESSED);
+  }
+
+  bool InputSnapshot::buttonReleased(int button) const {
+    return button >= 0 && button < 8 && (buttons[button] & INPUT_RELEASED);
+  }
+
+  Input::Input() {
+    memset(&snapshot, 0, sizeof(snapshot));
+    dropped = 0;
+    watching = false;
+  }
+
+  Input::~Input() {
+    stop();
+  }
+
+  void Input::start() {
+    if(!watching) {
+      SDL_AddEventWatch(watch, this);
+      watching = true;
+    }
+  }
+
+  void Input::stop() {
+    if(watching) {
+      SDL_DelEventWatch(watch, this);
+      watching = false;
+    }
+  }
+
+  int Input::watch(void* userdata, SDL_Event* event) {
+    // Called by SDL on the thread pumping events, as soon as it has them
+    ((Input*)userdata)->push(event);
+    return 1;
+  }
+
+  bool Input::push(const SDL_Event* event) {
+    switch(event->type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+    case SDL_MOUSEMOTION:
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+    case SDL_MOUSEWHEEL:
+      break;
+    default:
+      return true;
+    }
+    if(!ring.push({SDL_GetPerformanceCounter(), *event})) {
+      dropped++;
+      return false;
+    }
+    return true;
+  }
+
+  void Input::clearEdges() {
+    // Edges only last one tick, held state carries over
+    for(int i = 0; i < SDL_NUM_SCANCODES; i++) {
+      snapshot.keys[i] &= INPUT_HELD;
+    }
+    for(int i = 0; i < 8; i++) {
+      snapshot.buttons[i] &= INPUT_HELD;
+    }
+    snapshot.wheelX = 0;
+    snapshot.wheelY = 0;
+    events.clear();
+  }
+
+  void Input::apply(const InputEvent& input) {
+    events.push_back(input);
+    const SDL_Event& event = input.event;
+    switch(event.type) {
+    case SDL_KEYDOWN:
+      if(!event.key.repeat && event.key.keysym.scancode >= 0 && event.key.keysym.scancode < SDL_NUM_SCANCODES) {
+        snapshot.keys[event.key.keysym.scancode] |= INPUT_HELD | INPUT_PRESSED;
+      }
+      break;
+    case SDL_KEYUP:
+      if(event.key.keysym.scancode >= 0 && event.key.keysym.scancode < SDL_NUM_SCANCODES) {
+        Uint8& key = snapshot.keys[event.key.keysym.scancode];
+        key = (key & ~INPUT_HELD) | INPUT_RELEASED;
+      }
+      break;
+    case SDL_MOUSEMOTION:
+      snapshot.mouseX = event.motion.x;
+      snapshot.mouseY = event.motion.y;
+      break;
+    case SDL_MOUSEBUTTONDOWN:
+      if(event.button.button < 8) {
+        snapshot.buttons[event.button.button] |= INPUT_HELD | INPUT_PRESSED;
+      }
+      break;
+    case SDL_MOUSEBUTTONUP:
+      if(event.button.button < 8) {
+        Uint8& button = snapshot.buttons[event.button.button];
+        button = (button & ~INPUT_HELD) | INPUT_RELEASED;
+      }
+      break;
+    case SDL_MOUSEWHEEL:
+      snapshot.wheelX += event.wheel.x;
+      snapshot.wheelY += event.wheel.y;
+      break;
+    }
+  }
+
+  void Input::update() {
+    clearEdges();
+    InputEvent input;
+    while(ring.pop(input)) {
+      apply(input);
+    }
+    snapshot.time = SDL_GetPerformanceCounter();
+  }
+
+  void Input::replay(const std::vector<InputEvent>& recorded) {
+    clearEdges();
+    // Live input would break determinism, keep the ring from filling
+    InputEvent input;
+    while(ring.pop(input)) {}
+    for(const InputEvent& event : recorded) {
+      apply(event);
+    }
+    snapshot.time = SDL_GetPerformanceCounter();
+  }
+
+  const InputSnapshot* Input::getSnapshot() {
+    return &snapshot;
+  }
+
+  const std::vector<InputEvent>& Input::getEvents() {
+    return events;
+  }
+
+  int Input::getDropped() {
+    return dropped;
+  }
+}
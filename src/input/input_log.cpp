@@ -0,0 +1,232 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file input_log.cpp
+ *
+ * A blackhole library class for recording and replaying the input of every tick
+ */
+
+#include "input/input_log.h"
+#include <string.h>
+
+namespace blackhole::input {
+
+  // Written at the start of logs, followed by the version and the seed
+  const char INPUT_LOG_MAGIC[4] = {'B', 'H', 'I', 'L'};
+  const Uint32 INPUT_LOG_VERSION = 1;
+
+  // Events are kept as their type and the four fields Input reads
+  struct LoggedEvent {
+    Uint32 type;
+    Sint32 a;
+    Sint32 b;
+    Sint32 c;
+    Sint32 d;
+  };
+
+  static LoggedEvent packEvent(const SDL_Event& event) {
+    LoggedEvent packed = {event.type, 0, 0, 0, 0};
+    switch(event.type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+      packed = {event.type, event.key.keysym.scancode, event.key.repeat, event.key.keysym.sym, event.key.keysym.mod};
+      break;
+    case SDL_MOUSEMOTION:
+      packed = {event.type, event.motion.x, event.motion.y, event.motion.xrel, event.motion.yrel};
+      break;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+      packed = {event.type, event.button.button, event.button.clicks, event.button.x, event.button.y};
+      break;
+    case SDL_MOUSEWHEEL:
+      packed = {event.type, event.wheel.x, event.wheel.y, (Sint32)event.wheel.direction, 0};
+      break;
+    }
+    return packed;
+  }
+
+  static SDL_Event unpackEvent(const LoggedEvent& packed) {
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+    event.type = packed.type;
+    switch(packed.type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+      event.key.state = packed.type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+      event.key.keysym.scancode = (SDL_Scancode)packed.a;
+      event.key.repeat = packed.b;
+      event.key.keysym.sym = packed.c;
+      event.key.keysym.mod = packed.d;
+      break;
+    case SDL_MOUSEMOTION:
+      event.motion.x = packed.a;
+      event.motion.y = packed.b;
+      event.motion.xrel = packed.c;
+      event.motion.yrel = packed.d;
+      break;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+      event.button.state = packed.type == SDL_MOUSEBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+      event.button.button = packed.a;
+      event.button.clicks = packed.b;
+      event.button.x = packed.c;
+      event.button.y = packed.d;
+      break;
+    case SDL_MOUSEWHEEL:
+      event.wheel.x = packed.a;
+      event.wheel.y = packed.b;
+      event.wheel.direction = packed.c;
+      break;
+    }
+    return event;
+  }
+
+  InputLog::InputLog() {
+    out = NULL;
+    position = 0;
+    seed = 0;
+  }
+
+  InputLog::~InputLog() {
+    close();
+  }
+
+  bool InputLog::record(const char* file, Uint64 seed) {
+    close();
+    out = fopen(file, "wb");
+    if(out == NULL) {
+      printf("Failed to open %s for writing\n", file);
+      return false;
+    }
+    this->seed = seed;
+    fwrite(INPUT_LOG_MAGIC, 1, 4, out);
+    fwrite(&INPUT_LOG_VERSION, sizeof(Uint32), 1, out);
+    fwrite(&seed, sizeof(Uint64), 1, out);
+    return true;
+  }
+
+  void InputLog::writeTick(Uint64 tick, double deltaTime, const std::vector<InputEvent>& events) {
+    if(out == NULL) {
+      return;
+    }
+    Uint32 count = events.size();
+    fwrite(&tick, sizeof(Uint64), 1, out);
+    fwrite(&deltaTime, sizeof(double), 1, out);
+    fwrite(&count, sizeof(Uint32), 1, out);
+    for(const InputEvent& event : events) {
+      LoggedEvent packed = packEvent(event.event);
+      fwrite(&packed, sizeof(LoggedEvent), 1, out);
+    }
+  }
+
+  bool InputLog::load(const char* file) {
+    close();
+    FILE* in = fopen(file, "rb");
+    if(in == NULL) {
+      printf("Failed to open %s\n", file);
+      return false;
+    }
+
+    char magic[4];
+    Uint32 version = 0;
+    bool ok = fread(magic, 1, 4, in) == 4
+      && memcmp(magic, INPUT_LOG_MAGIC, 4) == 0
+      && fread(&version, sizeof(Uint32), 1, in) == 1
+      && version == INPUT_LOG_VERSION
+      && fread(&seed, sizeof(Uint64), 1, in) == 1;
+
+    if(!ok) {
+      fclose(in);
+      printf("Failed to read input log %s\n", file);
+      close();
+      return false;
+    }
+
+    // The log ends wherever recording stopped, which may be part way
+    // through a tick if the game was killed. The complete ticks before it
+    // are kept
+    Tick tick;
+    bool complete = true;
+    while(complete && fread(&tick.tick, sizeof(Uint64), 1, in) == 1) {
+      complete = fread(&tick.deltaTime, sizeof(double), 1, in) == 1
+        && fread(&tick.numEvents, sizeof(Uint32), 1, in) == 1;
+      tick.firstEvent = events.size();
+      for(Uint32 i = 0; complete && i < tick.numEvents; i++) {
+        LoggedEvent packed;
+        complete = fread(&packed, sizeof(LoggedEvent), 1, in) == 1;
+        if(complete) {
+          events.push_back({0, unpackEvent(packed)});
+        }
+      }
+      if(complete) {
+        ticks.push_back(tick);
+      }
+      else {
+        events.resize(tick.firstEvent);
+        printf("Input log %s ends in a partial tick, replaying %zu ticks\n", file, ticks.size());
+      }
+    }
+    fclose(in);
+    return true;
+  }
+
+  bool InputLog::readTick(Input* input, double* deltaTime, Uint64* tickNumber) {
+    if(position >= ticks.size()) {
+      return false;
+    }
+    Tick& tick = ticks[position++];
+    replayed.assign(events.begin() + tick.firstEvent, events.begin() + tick.firstEvent + tick.numEvents);
+    input->replay(replayed);
+    *deltaTime = tick.deltaTime;
+    *tickNumber = tick.tick;
+    return true;
+  }
+
+  void InputLog::close() {
+    if(out != NULL) {
+      fclose(out);
+      out = NULL;
+    }
+    ticks.clear();
+    events.clear();
+    position = 0;
+  }
+
+  bool InputLog::isRecording() {
+    return out != NULL;
+  }
+
+  bool InputLog::isReplaying() {
+    return position < ticks.size();
+  }
+
+  Uint64 InputLog::getSeed() {
+    return seed;
+  }
+
+  int InputLog::getTickCount() {
+    return ticks.size();
+  }
+}
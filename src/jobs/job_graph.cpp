@@ -0,0 +1,97 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file job_graph.cpp
+ *
+ * A blackhole library class for running jobs that depend on each other
+ */
+
+#include "jobs/job_graph.h"
+#include <stdio.h>
+
+namespace blackhole::jobs {
+
+  JobId JobGraph::addJob(const char* name, std::initializer_list<JobId> dependencies, std::function<void()> execute) {
+    JobId id = jobs.size();
+    Job* job = new Job();
+    job->name = name;
+    job->execute = execute;
+    job->dependencies = 0;
+    for(JobId dependency : dependencies) {
+      if(dependency < 0 || dependency >= id) {
+        printf("Job %s depends on a job not yet added\n", name);
+        continue;
+      }
+      jobs[dependency]->dependents.push_back(id);
+      job->dependencies++;
+    }
+    jobs.push_back(std::unique_ptr<Job>(job));
+    return id;
+  }
+
+  JobId JobGraph::addParallelFor(const char* name, std::initializer_list<JobId> dependencies, int count, int grain, std::function<void(int begin, int end)> execute) {
+    return addJob(name, dependencies, [this, count, grain, execute]() {
+      // The job waits on its own chunks, helping run them meanwhile
+      pool->parallelFor(count, grain, execute);
+    });
+  }
+
+  void JobGraph::schedule(JobId id, std::atomic<int>* counter) {
+    pool->submit([this, id, counter]() {
+      Job* job = jobs[id].get();
+      job->execute();
+      // Dependents are queued before this task counts as done so the
+      // counter can not reach 0 while there is still work to start
+      for(JobId dependent : job->dependents) {
+        if(jobs[dependent]->pending.fetch_sub(1) == 1) {
+          schedule(dependent, counter);
+        }
+      }
+    }, counter);
+  }
+
+  void JobGraph::execute(ThreadPool* pool) {
+    this->pool = pool;
+    for(auto& job : jobs) {
+      job->pending = job->dependencies;
+    }
+    std::atomic<int> counter(0);
+    for(int i = 0; i < (int)jobs.size(); i++) {
+      if(jobs[i]->dependencies == 0) {
+        schedule(i, &counter);
+      }
+    }
+    pool->wait(&counter);
+    clear();
+  }
+
+  void JobGraph::clear() {
+    jobs.clear();
+  }
+
+  int JobGraph::getCount() {
+    return jobs.size();
+  }
+}
@@ -0,0 +1,187 @@
+/*
+  MIT License
+
+  Copyright (c) 2021 Ashton Warner
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+/**
+ * \file thread_pool.cpp
+ *
+ * A blackhole library work stealing pool of worker threads
+ */
+
+#include "jobs/thread_pool.h"
+
+namespace blackhole::jobs {
+
+  // The queue owned by the calling thread, -1 off the pool
+  static thread_local int currentWorker = -1;
+  static thread_local ThreadPool* currentPool = NULL;
+
+  ThreadPool::ThreadPool(int threads) {
+    if(threads <= 0) {
+      threads = (int)std::thread::hardware_concurrency() - 1;
+      if(threads < 1) {
+        threads = 1;
+      }
+    }
+    running = true;
+    queued = 0;
+    nextWorker = 0;
+    for(int i = 0; i < threads; i++) {
+      workers.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+    for(int i = 0; i < threads; i++) {
+      this->threads.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+    }
+  }
+
+  ThreadPool::~ThreadPool() {
+    while(runOne()) {
+    }
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      running = false;
+    }
+    wake.notify_all();
+    for(std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  ThreadPool* ThreadPool::getDefault() {
+    static ThreadPool pool;
+    return &pool;
+  }
+
+  void ThreadPool::submit(std::function<void()> task, std::atomic<int>* counter) {
+    std::function<void()> wrapped = task;
+    if(counter != NULL) {
+      counter->fetch_add(1);
+      wrapped = [task, counter]() {
+        task();
+        counter->fetch_sub(1);
+      };
+    }
+
+    // Workers queue their own tasks so they stay on the same core
+    int worker = currentPool == this ? currentWorker : nextWorker++ % workers.size();
+    {
+      std::lock_guard<std::mutex> lock(workers[worker]->mutex);
+      workers[worker]->tasks.push_back(wrapped);
+    }
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      queued++;
+    }
+    wake.notify_one();
+  }
+
+  bool ThreadPool::pop(int worker, std::function<void()>& task) {
+    std::lock_guard<std::mutex> lock(workers[worker]->mutex);
+    if(workers[worker]->tasks.empty()) {
+      return false;
+    }
+    task = std::move(workers[worker]->tasks.back());
+    workers[worker]->tasks.pop_back();
+    return true;
+  }
+
+  bool ThreadPool::steal(int worker, std::function<void()>& task) {
+    int count = workers.size();
+    for(int i = 1; i <= count; i++) {
+      Worker* victim = workers[(worker + i) % count].get();
+      std::lock_guard<std::mutex> lock(victim->mutex);
+      if(!victim->tasks.empty()) {
+        task = std::move(victim->tasks.front());
+        victim->tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ThreadPool::runOne() {
+    std::function<void()> task;
+    int worker = currentPool == this ? currentWorker : 0;
+    if(!(currentPool == this && pop(worker, task)) && !steal(worker, task)) {
+      return false;
+    }
+    queued--;
+    task();
+    return true;
+  }
+
+  void ThreadPool::workerLoop(int worker) {
+    currentWorker = worker;
+    currentPool = this;
+    while(true) {
+      if(runOne()) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      wake.wait(lock, [this]() { return queued > 0 || !running; });
+      if(!running && queued <= 0) {
+        return;
+      }
+    }
+  }
+
+  void ThreadPool::wait(std::atomic<int>* counter) {
+    while(counter->load() > 0) {
+      if(!runOne()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void ThreadPool::parallelFor(int count, int grain, const std::function<void(int begin, int end)>& function) {
+    if(count <= 0) {
+      return;
+    }
+    if(grain < 1) {
+      grain = 1;
+    }
+    // A few chunks per thread so stealing can even out uneven chunks
+    int chunks = (getThreadCount() + 1) * 4;
+    int size = (count + chunks - 1) / chunks;
+    if(size < grain) {
+      size = grain;
+    }
+    if(size >= count) {
+      function(0, count);
+      return;
+    }
+
+    std::atomic<int> counter(0);
+    for(int begin = size; begin < count; begin += size) {
+      int end = begin + size < count ? begin + size : count;
+      submit([&function, begin, end]() { function(begin, end); }, &counter);
+    }
+    // The caller takes the first chunk rather than sitting idle
+    function(0, size);
+    wait(&counter);
+  }
+
+  int ThreadPool::getThreadCount() {
+    return threads.size();
+  }
+}